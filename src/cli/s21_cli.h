@@ -27,10 +27,13 @@ class CLI {
   void MenuSymHandle(int &error);
   int ValidateMenuSym();
   void LoadPath();
+  int LoadGraph();
   void ShowMenu();
   void PrintResultVector(std::vector<int> result);
   void SwitchAlgo();
-  void PrintResultMatrix(std::vector<std::vector<int>> result);
+  void PrintResultMatrix(const std::vector<std::vector<int>> &result);
+  void PrintShortestPathsMatrix();
+  void PrintResultRow(const int *row, int size);
   int SelectNumber(const char *description, int max_vertex);
   void ShortestPath();
   int ValidateVertexSym();
@@ -41,6 +44,7 @@ class CLI {
   void RollingCursor();
   Graph graph_;
   GraphAlgorithms algo_;
+  SearchWorkspace workspace_;
   std::string path_;
   int ch_;
   std::atomic<bool> stop_spinner_;
@@ -21,7 +21,7 @@ void CLI::PathSymHandle(int &error) {
     if (ch_ != (char)'\n' && ch_ != KEY_RESIZE) {
       path_.append(1, (wchar_t)ch_);
     } else if (ch_ == (char)'\n') {
-      error = graph_.LoadGraphFromFile(path_);
+      error = LoadGraph();
       if (error) {
         ErrorHandle(error);
         printw("Please, enter a path to the file:\n");
@@ -41,4 +41,19 @@ void CLI::PathSymHandle(int &error) {
   }
 }
 
+int CLI::LoadGraph() {
+  int error = 0;
+  std::filesystem::path extension = std::filesystem::path(path_).extension();
+  if (extension == ".el" || extension == ".edges") {
+    error = graph_.LoadGraphFromEdgeList(path_);
+  } else if (extension == ".snap") {
+    error = graph_.LoadGraphFromSnapshot(path_);
+  } else {
+    LoadOptions options;
+    options.threads = 0;
+    error = graph_.LoadGraphFromFile(path_, options);
+  }
+  return error;
+}
+
 }  // namespace s21
\ No newline at end of file
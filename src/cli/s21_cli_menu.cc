@@ -87,17 +87,44 @@ void CLI::PrintResultVector(std::vector<int> result) {
   RedrawWindow();
 }
 
-void CLI::PrintResultMatrix(std::vector<std::vector<int>> result) {
+void CLI::PrintResultMatrix(const std::vector<std::vector<int>> &result) {
   printw("\tResult:\n");
   for (unsigned long int i = 0; i < result.size(); ++i) {
-    printw("\t");
-    for (unsigned long int j = 0; j < result[i].size(); ++j) {
-      printw("%d ", result[i][j]);
+    PrintResultRow(result[i].data(), result[i].size());
+  }
+  printw("Enter next function number or press <Enter> to show main menu.\n");
+  RedrawWindow();
+}
+
+// Матрица, помещающаяся в kMaxMatrixBytes, считается целиком, чтобы плотные
+// графы шли через Флойда-Уоршелла; строки большей печатаются по мере
+// готовности, и вся она не хранится
+void CLI::PrintShortestPathsMatrix() {
+  const size_t kMaxMatrixBytes = size_t(1) << 30;
+  printw("\tResult:\n");
+  int vertices_count = graph_.GetVerticesCount();
+  if ((size_t)vertices_count * vertices_count * sizeof(int) <=
+      kMaxMatrixBytes) {
+    DistanceMatrix matrix;
+    algo_.GetShortestPathsBetweenAllVertices(graph_, matrix);
+    for (int i = 0; i < vertices_count; ++i) {
+      PrintResultRow(matrix.GetRow(i), vertices_count);
     }
-    printw("\n");
+  } else {
+    algo_.StreamShortestPathsBetweenAllVertices(
+        graph_,
+        [&](int, const int *row) { PrintResultRow(row, vertices_count); });
   }
   printw("Enter next function number or press <Enter> to show main menu.\n");
   RedrawWindow();
 }
 
+void CLI::PrintResultRow(const int *row, int size) {
+  printw("\t");
+  for (int j = 0; j < size; ++j) {
+    printw("%d ", row[j]);
+  }
+  printw("\n");
+}
+
 }  // namespace s21
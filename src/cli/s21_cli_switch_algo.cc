@@ -22,8 +22,7 @@ void CLI::SwitchAlgo() {
       printw(
           "5: Search for the shortest paths between all pairs of vertices in "
           "the graph.\n");
-      result_matrix = algo_.GetShortestPathsBetweenAllVertices(graph_);
-      PrintResultMatrix(result_matrix);
+      PrintShortestPathsMatrix();
       break;
     case 54:
       printw("6: Search for the minimum spanning tree in the graph.\n");
@@ -135,22 +134,21 @@ void CLI::TraverseAlgos() {
 
 void CLI::ShortestPath() {
   int first_vertex = SelectNumber("first vertex", graph_.GetVerticesCount());
+  int second_vertex = 0;
   if (first_vertex) {
-    int second_vertex =
-        SelectNumber("second vertex", graph_.GetVerticesCount());
-    if (second_vertex) {
-      int result = algo_.GetShortestPathBetweenVertices(graph_, first_vertex,
-                                                        second_vertex);
-      printw("\tRoute length = ");
-      printw("%d\n", result);
-    } else {
-      printw("Error: Vertex must be not zero!\n");
-    }
+    second_vertex = SelectNumber("second vertex", graph_.GetVerticesCount());
+  }
+  if (first_vertex && second_vertex) {
+    RouteResult result = algo_.GetShortestRouteBetweenVertices(
+        graph_, first_vertex, second_vertex, workspace_);
+    printw("\tRoute length = ");
+    printw("%d\n", result.distance);
+    PrintResultVector(result.vertices);
   } else {
     printw("Error: Vertex must be not zero!\n");
+    printw("Enter next function number or press <Enter> to show main menu.\n");
+    RedrawWindow();
   }
-  printw("Enter next function number or press <Enter> to show main menu.\n");
-  RedrawWindow();
 }
 
 }  // namespace s21
\ No newline at end of file
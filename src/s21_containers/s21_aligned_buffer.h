@@ -0,0 +1,131 @@
+#ifndef SRC_S21_ALIGNED_BUFFER_H
+#define SRC_S21_ALIGNED_BUFFER_H
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace s21 {
+// Fixed-size zero-initialized array of trivially copyable elements whose
+// storage starts on an Alignment-byte boundary (a cache line by default).
+// A buffer made by view() does not own its memory: it refers to storage kept
+// alive elsewhere (e.g. a memory-mapped file) and copies of it stay views.
+template <typename T, size_t Alignment = 64>
+class aligned_buffer {
+ public:
+  /*------------- ALIGNED BUFFER MEMBER TYPE -------------*/
+  using value_type = T;  // defines the type of an element
+  using reference = T&;  // defines the type of the reference to an element
+  using const_reference =
+      const T&;              // defines the type of the constant reference
+  using size_type = size_t;  // defines the type of the container size
+
+  static constexpr size_type alignment = Alignment;
+
+  /*------------- ALIGNED BUFFER CONSTRUCTORS -------------*/
+
+  // Default constructor, creates empty buffer
+  aligned_buffer() noexcept : data_(nullptr), size_(0), owns_(true) {}
+
+  // Parameterized constructor, creates zero-filled buffer of count elements
+  explicit aligned_buffer(size_type count) : aligned_buffer() {
+    assign(count);
+  }
+
+  // Copy constructor
+  aligned_buffer(const aligned_buffer& b) : aligned_buffer() { *this = b; }
+
+  // Move constructor
+  aligned_buffer(aligned_buffer&& b) noexcept : aligned_buffer() { swap(b); }
+
+  // Destructor
+  ~aligned_buffer() { Release(); }
+
+  // Non-owning buffer over count elements at data
+  static aligned_buffer view(T* data, size_type count) noexcept {
+    aligned_buffer b;
+    b.data_ = data;
+    b.size_ = count;
+    b.owns_ = false;
+    return b;
+  }
+
+  // Assignment operator overload for coping an object
+  aligned_buffer& operator=(const aligned_buffer& b) {
+    if (this != &b && !b.owns_) {
+      Release();
+      data_ = b.data_;
+      size_ = b.size_;
+      owns_ = false;
+    } else if (this != &b) {
+      assign(b.size_);
+      if (b.size_) std::memcpy(data_, b.data_, b.size_ * sizeof(T));
+    }
+    return *this;
+  }
+
+  // Assignment operator overload for moving object
+  aligned_buffer& operator=(aligned_buffer&& b) noexcept {
+    if (this != &b) {
+      Release();
+      swap(b);
+    }
+    return *this;
+  }
+
+  /*------------- ALIGNED BUFFER ELEMENT ACCESS -------------*/
+
+  reference operator[](size_type pos) noexcept { return data_[pos]; }
+  const_reference operator[](size_type pos) const noexcept {
+    return data_[pos];
+  }
+  T* data() noexcept { return data_; }
+  const T* data() const noexcept { return data_; }
+
+  /*------------- ALIGNED BUFFER CAPACITY -------------*/
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  bool owns_data() const noexcept { return owns_; }
+
+  /*------------- ALIGNED BUFFER MODIFIERS -------------*/
+
+  // Replaces the contents with count zero elements
+  void assign(size_type count) {
+    if (count != size_ || !owns_) {
+      Release();
+      if (count) {
+        data_ = static_cast<T*>(::operator new(
+            count * sizeof(T), std::align_val_t(Alignment)));
+        size_ = count;
+      }
+    }
+    if (size_) std::memset(data_, 0, size_ * sizeof(T));
+  }
+
+  // Releases the storage
+  void clear() noexcept { Release(); }
+
+  // Swaps the contents
+  void swap(aligned_buffer& other) noexcept {
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    std::swap(owns_, other.owns_);
+  }
+
+ private:
+  void Release() noexcept {
+    if (data_ && owns_) ::operator delete(data_, std::align_val_t(Alignment));
+    data_ = nullptr;
+    size_ = 0;
+    owns_ = true;
+  }
+
+  T* data_;
+  size_type size_;
+  bool owns_;
+};  // aligned_buffer
+}  // namespace s21
+
+#endif  // SRC_S21_ALIGNED_BUFFER_H
@@ -0,0 +1,89 @@
+#ifndef SRC_S21_DISJOINT_SET_H
+#define SRC_S21_DISJOINT_SET_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+// Partition of the elements 0 .. size - 1 into disjoint sets (union-find).
+// find() compresses the path it walks and merge() hangs the lower-ranked
+// root under the other, so any sequence of operations costs nearly O(1)
+// amortized per operation.
+class disjoint_set {
+ public:
+  /*------------- DISJOINT SET MEMBER TYPE -------------*/
+  using value_type = int;    // defines the type of an element
+  using size_type = size_t;  // defines the type of the container size
+
+  /*------------- DISJOINT SET CONSTRUCTORS -------------*/
+
+  // Default constructor, creates empty partition
+  disjoint_set() = default;
+
+  // Parameterized constructor, puts every element below size in its own set
+  explicit disjoint_set(size_type size) { reset(size); }
+
+  /*------------- DISJOINT SET LOOKUP -------------*/
+
+  // Representative of the set holding element
+  value_type find(value_type element) noexcept {
+    value_type root = element;
+    while (parent_[root] != root) root = parent_[root];
+    while (parent_[element] != root) {
+      value_type next = parent_[element];
+      parent_[element] = root;
+      element = next;
+    }
+    return root;
+  }
+
+  bool same(value_type first, value_type second) noexcept {
+    return find(first) == find(second);
+  }
+
+  /*------------- DISJOINT SET CAPACITY -------------*/
+
+  size_type size() const noexcept { return parent_.size(); }
+  // Number of sets
+  size_type count() const noexcept { return count_; }
+
+  /*------------- DISJOINT SET MODIFIERS -------------*/
+
+  // Puts every element below size in its own set
+  void reset(size_type size) {
+    parent_.resize(size);
+    for (size_type i = 0; i < size; ++i) parent_[i] = i;
+    rank_.assign(size, 0);
+    count_ = size;
+  }
+
+  // Unites the sets of first and second; false if they were already one set
+  bool merge(value_type first, value_type second) noexcept {
+    first = find(first);
+    second = find(second);
+    bool merged = first != second;
+    if (merged) {
+      if (rank_[first] < rank_[second]) std::swap(first, second);
+      parent_[second] = first;
+      if (rank_[first] == rank_[second]) ++rank_[first];
+      --count_;
+    }
+    return merged;
+  }
+
+  // Swaps the contents
+  void swap(disjoint_set& other) noexcept {
+    parent_.swap(other.parent_);
+    rank_.swap(other.rank_);
+    std::swap(count_, other.count_);
+  }
+
+ private:
+  std::vector<value_type> parent_;
+  std::vector<unsigned char> rank_;  // rank never exceeds log2(size)
+  size_type count_ = 0;
+};  // disjoint_set
+}  // namespace s21
+
+#endif  // SRC_S21_DISJOINT_SET_H
@@ -0,0 +1,146 @@
+#ifndef SRC_S21_INDEXED_HEAP_H
+#define SRC_S21_INDEXED_HEAP_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+// Min-heap of the integer keys 0 .. capacity - 1 ordered by a priority of
+// type P. Every key is in the heap at most once and a key-to-position index
+// gives O(log n) decrease-key. Arity is the number of children of a node: 4
+// keeps the heap shallow and the children of a node in one cache line.
+template <typename P, size_t Arity = 4>
+class indexed_heap {
+ public:
+  /*------------- INDEXED HEAP MEMBER TYPE -------------*/
+  using key_type = int;      // defines the type of a key
+  using priority_type = P;   // defines the type of a priority
+  using size_type = size_t;  // defines the type of the container size
+
+  static constexpr size_type arity = Arity;
+
+  /*------------- INDEXED HEAP CONSTRUCTORS -------------*/
+
+  // Default constructor, creates empty heap without keys
+  indexed_heap() = default;
+
+  // Parameterized constructor, creates empty heap for keys below capacity
+  explicit indexed_heap(size_type capacity) : position_(capacity, kAbsent) {}
+
+  /*------------- INDEXED HEAP ELEMENT ACCESS -------------*/
+
+  // Key with the smallest priority
+  key_type top() const noexcept { return nodes_.front().key; }
+
+  // Smallest priority
+  priority_type top_priority() const noexcept {
+    return nodes_.front().priority;
+  }
+
+  /*------------- INDEXED HEAP CAPACITY -------------*/
+
+  bool empty() const noexcept { return nodes_.empty(); }
+  size_type size() const noexcept { return nodes_.size(); }
+  size_type capacity() const noexcept { return position_.size(); }
+  bool contains(key_type key) const noexcept {
+    return position_[key] != kAbsent;
+  }
+
+  /*------------- INDEXED HEAP MODIFIERS -------------*/
+
+  // Empties the heap and makes it hold keys below capacity
+  void reset(size_type capacity) {
+    nodes_.clear();
+    position_.assign(capacity, kAbsent);
+  }
+
+  // Empties the heap in O(size())
+  void clear() noexcept {
+    for (const node& n : nodes_) position_[n.key] = kAbsent;
+    nodes_.clear();
+  }
+
+  // Inserts key that is not in the heap
+  void push(key_type key, priority_type priority) {
+    nodes_.push_back({priority, key});
+    SiftUp(nodes_.size() - 1);
+  }
+
+  // Lowers the priority of key that is in the heap
+  void decrease(key_type key, priority_type priority) noexcept {
+    size_type pos = position_[key];
+    nodes_[pos].priority = priority;
+    SiftUp(pos);
+  }
+
+  // Inserts key or lowers its priority; keeps a smaller present priority
+  void push_or_decrease(key_type key, priority_type priority) {
+    if (!contains(key)) {
+      push(key, priority);
+    } else if (priority < nodes_[position_[key]].priority) {
+      decrease(key, priority);
+    }
+  }
+
+  // Removes the key with the smallest priority
+  void pop() noexcept {
+    position_[nodes_.front().key] = kAbsent;
+    node last = nodes_.back();
+    nodes_.pop_back();
+    if (!nodes_.empty()) SiftDown(last);
+  }
+
+  // Swaps the contents
+  void swap(indexed_heap& other) noexcept {
+    nodes_.swap(other.nodes_);
+    position_.swap(other.position_);
+  }
+
+ private:
+  struct node {
+    priority_type priority;
+    key_type key;
+  };
+
+  static constexpr size_type kAbsent = static_cast<size_type>(-1);
+
+  void Place(size_type pos, const node& n) noexcept {
+    nodes_[pos] = n;
+    position_[n.key] = pos;
+  }
+
+  void SiftUp(size_type pos) noexcept {
+    node n = nodes_[pos];
+    while (pos > 0) {
+      size_type parent = (pos - 1) / Arity;
+      if (!(n.priority < nodes_[parent].priority)) break;
+      Place(pos, nodes_[parent]);
+      pos = parent;
+    }
+    Place(pos, n);
+  }
+
+  // Fills the hole at the root with n
+  void SiftDown(const node& n) noexcept {
+    size_type pos = 0;
+    size_type count = nodes_.size();
+    for (size_type first = 1; first < count; first = pos * Arity + 1) {
+      size_type best = first;
+      size_type last = first + Arity < count ? first + Arity : count;
+      for (size_type child = first + 1; child < last; ++child) {
+        if (nodes_[child].priority < nodes_[best].priority) best = child;
+      }
+      if (!(nodes_[best].priority < n.priority)) break;
+      Place(pos, nodes_[best]);
+      pos = best;
+    }
+    Place(pos, n);
+  }
+
+  std::vector<node> nodes_;
+  std::vector<size_type> position_;
+};  // indexed_heap
+}  // namespace s21
+
+#endif  // SRC_S21_INDEXED_HEAP_H
@@ -0,0 +1,28 @@
+#ifndef A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_S21_BINARY_FILE_H
+#define A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_S21_BINARY_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace s21 {
+
+// Helpers shared by the binary files of the library: graph snapshots,
+// landmark tables and contraction hierarchies. Their load and export
+// functions return the same codes: 1 if the file cannot be opened or
+// written, 2 if it is corrupt or was computed for another graph, 4 if the
+// file to export already exists.
+
+// 64-bit FNV-1a, used for file checksums and Graph::GetFingerprint
+const uint64_t kFnvOffset = 14695981039346656037ull;
+const uint64_t kFnvPrime = 1099511628211ull;
+
+// Folds bytes into hash; a new hash starts from kFnvOffset
+inline uint64_t HashBytes(uint64_t hash, const void *data, size_t bytes) {
+  const unsigned char *begin = static_cast<const unsigned char *>(data);
+  for (size_t i = 0; i < bytes; i++) hash = (hash ^ begin[i]) * kFnvPrime;
+  return hash;
+}
+
+}  // namespace s21
+
+#endif  // A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_S21_BINARY_FILE_H
\ No newline at end of file
@@ -24,17 +24,33 @@ void Graph::ExportToStream(std::ofstream *out) {
   int count = GetVerticesCount();
   for (int i = 1; i <= count; i++) *out << "    " << i << ";\n";
   for (int row = 0; row < count; row++) {
-    for (int col = 0; col < count; col++) {
-      if (matrix_[row][col] != 0 && row <= col) {
-        *out << "    " << row + 1 << " -";
-        *out << "- ";
-        *out << col + 1;
-        *out << " [ label = \"" << matrix_[row][col] << "\"]";
-        *out << ";\n";
+    if (HasMatrix()) {
+      // Веса с col >= row есть в строке при любом способе хранения матрицы
+      VisitWeightType(weight_type_, [&](auto zero) {
+        const auto *values = GetMatrixRow<decltype(zero)>(row);
+        for (int col = row; col < count; col++) {
+          if (values[col] != 0) ExportEdge(out, row, col, values[col]);
+        }
+      });
+    } else {
+      int loop = GetVergeWeight(row + 1, row + 1);
+      if (loop) ExportEdge(out, row, row, loop);
+      for (Neighbor neighbor : GetNeighbors(row + 1)) {
+        if (neighbor.vertex > row + 1) {
+          ExportEdge(out, row, neighbor.vertex - 1, neighbor.weight);
+        }
       }
     }
   }
   *out << "}";
 }
 
+void Graph::ExportEdge(std::ofstream *out, int row, int col, int weight) {
+  *out << "    " << row + 1 << " -";
+  *out << "- ";
+  *out << col + 1;
+  *out << " [ label = \"" << weight << "\"]";
+  *out << ";\n";
+}
+
 }  // namespace s21
\ No newline at end of file
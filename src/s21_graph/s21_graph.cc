@@ -1,11 +1,15 @@
 #include "s21_graph.h"
 
+#include <algorithm>
+
+#include "s21_binary_file.h"
+
 namespace s21 {
 
 int Graph::GetVal(int x, int y, int *value) {
   int error = 0;
   if (x < n_ && y < n_) {
-    *value = matrix_[x][y];
+    *value = GetVergeWeight(x + 1, y + 1);
   } else {
     error = 1;
   }
@@ -13,38 +17,208 @@ int Graph::GetVal(int x, int y, int *value) {
 }
 
 void Graph::ClearData() {
-  n_ = 0;
-  matrix_.clear();
-  matrix_.resize(0, std::vector<int>(0, 0));
+  loops_.clear();
+  neighbors_.clear();
+  weights_.clear();
+  layout_ = MatrixLayout::kFull;
+  AllocateMatrix(0, WeightType::kUint8);
+  offsets_.assign(1);
+  snapshot_.reset();
+  revision_ = NextRevision();
+  BuildAdjacencyIndex();
 }
 
-int Graph::CheckDirWeight() {
-  int error = 0;
-  int weights = 0;
+// FNV-1a по размеру графа, типу весов и массивам индекса смежности
+uint64_t Graph::GetFingerprint() const {
+  int entries = offsets_[n_];
+  int weight_size = GetWeightSize(weight_type_);
+  uint64_t hash = HashBytes(kFnvOffset, &n_, sizeof(int));
+  hash = HashBytes(hash, &weight_size, sizeof(int));
+  hash = HashBytes(hash, offsets_.data(), (n_ + 1) * sizeof(int));
+  hash = HashBytes(hash, neighbors_.data(), entries * sizeof(int));
+  return HashBytes(hash, weights_.data(), (size_t)entries * weight_size);
+}
+
+uint64_t Graph::NextRevision() {
+  static std::atomic<uint64_t> last_revision(0);
+  return ++last_revision;
+}
+
+// Выделяет обнулённую матрицу n x n в раскладке layout_ с весами типа type
+void Graph::AllocateMatrix(int n, WeightType type) {
+  const int per_line =
+      aligned_buffer<unsigned char>::alignment / GetWeightSize(type);
+  n_ = n;
+  weight_type_ = type;
+  stride_ = 0;
+  if (layout_ == MatrixLayout::kFull) {
+    stride_ = (n + per_line - 1) / per_line * per_line;
+  }
+  matrix_.assign(GetMatrixSize() * GetWeightSize(type));
+}
+
+size_t Graph::GetMatrixSize() const {
+  if (layout_ == MatrixLayout::kFull) return (size_t)n_ * stride_;
+  return (size_t)n_ * (n_ + 1) / 2;
+}
+
+// Переводит матрицу в более широкий тип весов, сохраняя прочитанные строки
+void Graph::WidenMatrix(WeightType type) {
+  aligned_buffer<unsigned char> narrow;
+  narrow.swap(matrix_);
+  WeightType narrow_type = weight_type_;
+  int narrow_stride = stride_;
+  AllocateMatrix(n_, type);
+  VisitWeightType(narrow_type, [&](auto old_zero) {
+    using Old = decltype(old_zero);
+    const Old *source = reinterpret_cast<const Old *>(narrow.data());
+    VisitWeightType(type, [&](auto new_zero) {
+      using New = decltype(new_zero);
+      if (layout_ == MatrixLayout::kFull) {
+        for (int row = 0; row < n_; row++) {
+          const Old *values = source + (size_t)row * narrow_stride;
+          std::copy(values, values + n_, GetMutableRow<New>(row));
+        }
+      } else {
+        std::copy(source, source + GetMatrixSize(), GetMutableRow<New>(0));
+      }
+    });
+  });
+}
+
+// Веса и число рёбер каждой строки собираются ещё при разборе файла. Ошибка 3
+// (граф не взвешен) перекрывает ошибку 2, поэтому остальные проверки идут
+// только для взвешенного графа и прекращаются на первом нарушении. Для
+// верхнетреугольного хранения симметричность проверена при разборе.
+int Graph::CheckDirWeight(const ParseStats &stats, ThreadPool *pool) {
+  int error = stats.max_weight > 1 ? 0 : 3;
   int count = GetVerticesCount();
-  for (int i = 0; i < count; i++) {
-    int bounds = 0;
-    for (int j = 0; j < count; j++) {
-      if (matrix_[i][j] != matrix_[j][i]) error = 2;
-      if (matrix_[i][j] != 0 && matrix_[i][j] != 1) weights = 1;
-      bounds = bounds + matrix_[i][j];
-    }
-    if (!bounds) error = 2;
+  for (int i = 0; i < count && !error; i++) {
+    if (offsets_[i + 1] == 0 && GetVergeWeight(i + 1, i + 1) == 0) error = 2;
+  }
+  if (!error && layout_ == MatrixLayout::kUpperTriangular) {
+    if (stats.asymmetric) error = 2;
+  } else if (!error) {
+    std::atomic<bool> asymmetric(false);
+    int blocks = (count + kSymmetryTile - 1) / kSymmetryTile;
+    pool->ParallelFor(blocks, [&](int block, int) {
+      bool symmetric = VisitWeightType(weight_type_, [&](auto zero) {
+        return asymmetric ||
+               CheckSymmetricTiles<decltype(zero)>(block, asymmetric);
+      });
+      if (!symmetric) asymmetric = true;
+    });
+    if (asymmetric) error = 2;
   }
-  if (!weights) error = 3;
   return error;
 }
 
+// Сравнивает полосу плиток над диагональю, начиная с block_row, с
+// транспонированными плитками под ней. Плитка столбцов копируется в
+// локальный буфер, после чего строки сравниваются подряд по 64 байта.
+template <typename W>
+bool Graph::CheckSymmetricTiles(int block_row,
+                                const std::atomic<bool> &stop) const {
+  const int tile = kSymmetryTile;
+  const int group = aligned_buffer<unsigned char>::alignment / sizeof(W);
+  alignas(64) W transposed[kSymmetryTile * kSymmetryTile];
+  int row_begin = block_row * tile;
+  int rows = std::min(n_ - row_begin, tile);
+  bool symmetric = true;
+  for (int col_begin = row_begin; col_begin < n_ && symmetric && !stop;
+       col_begin += tile) {
+    int cols = std::min(n_ - col_begin, tile);
+    int width = (cols + group - 1) / group * group;  // хвост строки — нули
+    for (int i = 0; i < rows; i++) {
+      std::fill(transposed + i * tile + cols, transposed + i * tile + width, 0);
+    }
+    for (int j = 0; j < cols; j++) {
+      const W *source = GetMatrixRow<W>(col_begin + j) + row_begin;
+      for (int i = 0; i < rows; i++) transposed[i * tile + j] = source[i];
+    }
+    for (int i = 0; i < rows && symmetric; i++) {
+      const W *values = GetMatrixRow<W>(row_begin + i) + col_begin;
+      const W *mirror = transposed + i * tile;
+      W difference = 0;
+      for (int k = 0; k < width; k += group) {
+        for (int lane = 0; lane < group; lane++) {
+          difference |= values[k + lane] ^ mirror[k + lane];
+        }
+      }
+      symmetric = difference == 0;
+    }
+  }
+  return symmetric;
+}
+
 std::vector<int> Graph::GetAdjacentVertices(int vertex) {
   std::vector<int> result;
   int count = GetVerticesCount();
   if (vertex <= count && vertex > 0) {
-    for (int i = count - 1; i >= 0; i--) {
-      if (matrix_[i][vertex - 1] != 0 && i != (vertex - 1))
-        result.push_back(i + 1);
+    NeighborRange neighbors = GetNeighbors(vertex);
+    result.reserve(neighbors.size());
+    for (auto it = neighbors.rbegin(); it != neighbors.rend(); ++it) {
+      result.push_back((*it).vertex);
     }
   }
   return result;
 }
 
+int Graph::FindVergeWeight(int first, int second) const {
+  if (first == second) {
+    return ReadWeight(loops_.data(), first - 1, weight_type_);
+  }
+  const int *begin = neighbors_.data() + offsets_[first - 1];
+  const int *end = neighbors_.data() + offsets_[first];
+  const int *it = std::lower_bound(begin, end, second - 1);
+  return (it != end && *it == second - 1)
+             ? ReadWeight(weights_.data(), it - neighbors_.data(), weight_type_)
+             : 0;
+}
+
+void Graph::BuildAdjacencyIndex() {
+  int count = GetVerticesCount();
+  for (int row = 0; row < count; row++) offsets_[row + 1] += offsets_[row];
+  neighbors_.assign(offsets_[count]);
+  weights_.assign((size_t)offsets_[count] * GetWeightSize(weight_type_));
+  VisitWeightType(weight_type_, [&](auto zero) {
+    using W = decltype(zero);
+    if (layout_ == MatrixLayout::kUpperTriangular) {
+      FillPackedAdjacencyIndex<W>();
+      return;
+    }
+    W *weights = reinterpret_cast<W *>(weights_.data());
+    for (int row = 0; row < count; row++) {
+      const W *values = GetMatrixRow<W>(row);
+      int position = offsets_[row];
+      for (int col = 0; col < count; col++) {
+        if (values[col] != 0 && row != col) {
+          neighbors_[position] = col;
+          weights[position++] = values[col];
+        }
+      }
+    }
+  });
+}
+
+// Строка row верхнетреугольной матрицы даёт рёбра (row, col) и (col, row)
+// для col > row. Строки идут по возрастанию, поэтому соседи каждой вершины
+// попадают в её часть индекса уже упорядоченными.
+template <typename W>
+void Graph::FillPackedAdjacencyIndex() {
+  std::vector<int> cursor(offsets_.data(), offsets_.data() + n_);
+  W *weights = reinterpret_cast<W *>(weights_.data());
+  for (int row = 0; row < n_; row++) {
+    const W *values = GetMatrixRow<W>(row);
+    for (int col = row + 1; col < n_; col++) {
+      if (values[col] != 0) {
+        neighbors_[cursor[row]] = col;
+        weights[cursor[row]++] = values[col];
+        neighbors_[cursor[col]] = row;
+        weights[cursor[col]++] = values[col];
+      }
+    }
+  }
+}
+
 }  // namespace s21
\ No newline at end of file
@@ -1,39 +1,257 @@
 #ifndef A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_S21_GRAPH_H
 #define A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_S21_GRAPH_H
+#include <atomic>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <iterator>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include "../s21_containers/s21_aligned_buffer.h"
+#include "s21_mapped_file.h"
+#include "s21_thread_pool.h"
+#include "s21_weight_type.h"
+
 #define MAX_GRAPH_SIZE 2147483647
 
 namespace s21 {
 
+// Compressed-sparse-row view of the graph edges. Vertex ids are zero-based:
+// neighbours of vertex v are neighbors[offsets[v]] .. neighbors[offsets[v+1]]
+// in ascending order, loops are not included. Their weights are stored as
+// weight_type, GetWeights<W>() gives them with W matching it.
+struct AdjacencyIndex {
+  int vertices;
+  const int *offsets;
+  const int *neighbors;
+  const void *weights;
+  WeightType weight_type;
+  template <typename W>
+  const W *GetWeights() const {
+    return static_cast<const W *>(weights);
+  }
+};
+
+// Смежная вершина (нумерация с 1) и вес ребра до неё
+struct Neighbor {
+  int vertex;
+  int weight;
+};
+
+class NeighborIterator {
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = Neighbor;
+  using difference_type = std::ptrdiff_t;
+  using pointer = void;
+  using reference = Neighbor;
+
+  NeighborIterator()
+      : vertex_(nullptr),
+        first_(nullptr),
+        weights_(nullptr),
+        type_(WeightType::kInt32) {}
+  NeighborIterator(const int *vertex, const int *first, const void *weights,
+                   WeightType type)
+      : vertex_(vertex), first_(first), weights_(weights), type_(type) {}
+  Neighbor operator*() const {
+    return {*vertex_ + 1, ReadWeight(weights_, vertex_ - first_, type_)};
+  }
+  NeighborIterator &operator++() {
+    ++vertex_;
+    return *this;
+  }
+  NeighborIterator operator++(int) {
+    NeighborIterator tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  NeighborIterator &operator--() {
+    --vertex_;
+    return *this;
+  }
+  NeighborIterator operator--(int) {
+    NeighborIterator tmp = *this;
+    --*this;
+    return tmp;
+  }
+  bool operator==(const NeighborIterator &other) const {
+    return vertex_ == other.vertex_;
+  }
+  bool operator!=(const NeighborIterator &other) const {
+    return vertex_ != other.vertex_;
+  }
+
+ private:
+  const int *vertex_;
+  const int *first_;     // начало диапазона, от него считаются веса
+  const void *weights_;  // веса диапазона в типе type_
+  WeightType type_;
+};
+
+// Non-owning view of the neighbours of one vertex in ascending order. It
+// points into the graph storage and is invalidated by the next load.
+class NeighborRange {
+ public:
+  using iterator = NeighborIterator;
+  using reverse_iterator = std::reverse_iterator<NeighborIterator>;
+
+  NeighborRange(const int *vertices, const void *weights, WeightType type,
+                int size)
+      : vertices_(vertices), weights_(weights), type_(type), size_(size) {}
+  iterator begin() const {
+    return iterator(vertices_, vertices_, weights_, type_);
+  }
+  iterator end() const {
+    return iterator(vertices_ + size_, vertices_, weights_, type_);
+  }
+  reverse_iterator rbegin() const { return reverse_iterator(end()); }
+  reverse_iterator rend() const { return reverse_iterator(begin()); }
+  int size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+ private:
+  const int *vertices_;
+  const void *weights_;
+  WeightType type_;
+  int size_;
+};
+
+// Как хранится матрица смежности графа, загруженного из файла матрицы
+enum class MatrixLayout {
+  kFull,            // n строк по n весов, строки выровнены по 64 байтам
+  kUpperTriangular  // только веса (i, j) с i <= j, n * (n + 1) / 2 подряд
+};
+
+struct LoadOptions {
+  int threads = 1;  // потоков разбора файла, 0 — по числу ядер
+  MatrixLayout layout = MatrixLayout::kFull;
+};
+
 class Graph {
  public:
-  Graph() : n_(0), matrix_(0, std::vector<int>(0, 0)) {}
-  Graph(int n) : n_(n), matrix_(n, std::vector<int>(n, 0)) {}
-  int LoadGraphFromFile(std::string filename);
+  Graph() : Graph(0) {}
+  Graph(int n)
+      : n_(0),
+        stride_(0),
+        layout_(MatrixLayout::kFull),
+        weight_type_(WeightType::kUint8),
+        revision_(NextRevision()) {
+    AllocateMatrix(n, weight_type_);
+    offsets_.assign(n + 1);
+    BuildAdjacencyIndex();
+  }
+  int LoadGraphFromFile(std::string filename, LoadOptions options = {});
+  int LoadGraphFromEdgeList(std::string filename);
+  int LoadGraphFromSnapshot(std::string filename);
   int ExportGraphToDot(std::string filename);
+  int ExportGraphToSnapshot(std::string filename);
   void ClearData();
-  int GetVerticesCount() { return n_; }
+  int GetVerticesCount() const { return n_; }
   int GetVal(int x, int y, int *value);
-  int GetVergeWeight(int first, int second) {
-    return matrix_[first - 1][second - 1];
+  int GetVergeWeight(int first, int second) const {
+    if (!HasMatrix()) return FindVergeWeight(first, second);
+    if (layout_ == MatrixLayout::kUpperTriangular && first > second) {
+      std::swap(first, second);
+    }
+    size_t index = GetRowOffset(first - 1) + second - 1;
+    return ReadWeight(matrix_.data(), index, weight_type_);
+  }
+  // false for graphs loaded from an edge list, which keep only the CSR index
+  bool HasMatrix() const { return !matrix_.empty() || n_ == 0; }
+  MatrixLayout GetMatrixLayout() const { return layout_; }
+  // Type of all stored weights: the matrix, the CSR index and the loops
+  WeightType GetWeightType() const { return weight_type_; }
+  // Zero-based row of the adjacency matrix, W must match GetWeightType().
+  // Full rows are 64-byte aligned; in the upper-triangular layout only the
+  // elements from row on belong to the row.
+  template <typename W>
+  const W *GetMatrixRow(int row) const {
+    return reinterpret_cast<const W *>(matrix_.data()) + GetRowOffset(row);
   }
+  int GetMatrixStride() const { return stride_; }
   std::vector<int> GetAdjacentVertices(int vertex);
+  // Соседи вершины без выделения памяти, vertex нумеруется с 1
+  NeighborRange GetNeighbors(int vertex) const {
+    int begin = offsets_[vertex - 1];
+    return NeighborRange(neighbors_.data() + begin,
+                         weights_.data() + begin * GetWeightSize(weight_type_),
+                         weight_type_, offsets_[vertex] - begin);
+  }
+  AdjacencyIndex GetAdjacencyIndex() const {
+    return {n_, offsets_.data(), neighbors_.data(), weights_.data(),
+            weight_type_};
+  }
+  int GetEdgesCount() const { return neighbors_.size() / 2; }
+  // Номер содержимого графа, новый после каждой загрузки и очистки: по нему
+  // посчитанные для графа данные узнают, что граф сменился
+  uint64_t GetRevision() const { return revision_; }
+  // Отпечаток индекса смежности: совпадает у одинаковых графов, поэтому
+  // сохранённые в файл данные узнают граф, для которого посчитаны
+  uint64_t GetFingerprint() const;
 
  private:
-  int PushVal(std::vector<std::string> line_data, int row);
-  void LineHandle(std::vector<std::string> line_data, int *current_line,
-                  int *error);
-  int CheckSetRange(std::vector<std::string> line_data, int *form_success);
+  // Сведения о матрице, собираемые при разборе
+  struct ParseStats {
+    int max_weight = 0;
+    bool asymmetric = false;  // только для верхнетреугольного хранения
+  };
+  int ParseMatrixHead(const char **begin, const char *end, ParseStats *stats);
+  int ParseMatrixRows(const char *begin, const char *end, ThreadPool *pool,
+                      ParseStats *stats);
+  int ParseMatrixChunk(const char **begin, const char *end, int mirror_from,
+                       int *row, ParseStats *stats);
+  int ParseMatrixRow(const char *begin, const char *end, int row,
+                     int mirror_from, ParseStats *stats);
+  template <typename W>
+  int ParseMatrixRow(const char *begin, const char *end, int row,
+                     int mirror_from, ParseStats *stats);
+  bool CheckMirroredPrefix(const char *begin, const char *end, int first_row,
+                           int last_row);
+  template <typename W>
+  bool CheckMirroredPrefix(const char *begin, const char *end, int first_row,
+                           int last_row);
   void ExportToStream(std::ofstream *out);
-  int CheckDirWeight();
+  void ExportEdge(std::ofstream *out, int row, int col, int weight);
+  int CheckDirWeight(const ParseStats &stats, ThreadPool *pool);
+  template <typename W>
+  bool CheckSymmetricTiles(int block_row, const std::atomic<bool> &stop) const;
+  int FindVergeWeight(int first, int second) const;
+  int ParseEdgeListLine(const char *begin, const char *end,
+                        std::vector<int> *edges, long *declared_edges);
+  int BuildSparseIndex(const std::vector<int> &edges);
+  int CheckSnapshotIndex(int vertices, int entries, const int *offsets,
+                         const int *neighbors);
+  void AllocateMatrix(int n, WeightType type);
+  void WidenMatrix(WeightType type);
+  size_t GetMatrixSize() const;
+  size_t GetRowOffset(int row) const {
+    if (layout_ == MatrixLayout::kFull) return (size_t)row * stride_;
+    return (size_t)row * (2 * (size_t)n_ - row - 1) / 2;
+  }
+  template <typename W>
+  W *GetMutableRow(int row) {
+    return reinterpret_cast<W *>(matrix_.data()) + GetRowOffset(row);
+  }
+  void BuildAdjacencyIndex();
+  template <typename W>
+  void FillPackedAdjacencyIndex();
+  static uint64_t NextRevision();
+  static const int kSymmetryTile = 64;
   int n_;
-  std::vector<std::vector<int>> matrix_;
+  int stride_;  // длина строки полной матрицы в весах, кратная 64 байтам
+  MatrixLayout layout_;
+  WeightType weight_type_;
+  uint64_t revision_;
+  aligned_buffer<unsigned char> matrix_;
+  aligned_buffer<int> offsets_;
+  aligned_buffer<int> neighbors_;
+  aligned_buffer<unsigned char> weights_;
+  aligned_buffer<unsigned char> loops_;  // веса петель, если матрицы нет
+  std::shared_ptr<MappedFile> snapshot_;  // память массивов-представлений
 };
 
 }  // namespace s21
@@ -0,0 +1,270 @@
+#include "s21_graph.h"
+
+#include <cstdint>
+#include <cstring>
+
+#include "s21_binary_file.h"
+
+namespace s21 {
+
+namespace {
+
+// Файл снимка: заголовок и массивы графа в порядке offsets, neighbors,
+// weights, затем matrix (плотный граф) или loops (граф из списка рёбер).
+// Матрица хранится строками по stride весов или, с флагом
+// kSnapshotUpperTriangular, верхним треугольником без выравнивания строк.
+// Каждая секция начинается с границы 64 байт, байты хранятся в порядке
+// текущей платформы. Веса (weights, matrix, loops) занимают weight_size байт,
+// в версии 1 они всегда int.
+const char kSnapshotMagic[8] = {'S', '2', '1', 'G', 'R', 'A', 'P', 'H'};
+const uint32_t kSnapshotVersion = 2;
+const uint32_t kSnapshotHasMatrix = 1;
+const uint32_t kSnapshotUpperTriangular = 2;
+const uint64_t kSectionAlignment = 64;
+
+struct SnapshotHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t flags;
+  int64_t vertices;
+  int64_t stride;
+  int64_t entries;  // длина массивов neighbors и weights
+  uint64_t file_size;
+  uint64_t checksum;  // по всем секциям после заголовка
+  uint32_t weight_size;
+  uint32_t reserved;
+};
+
+static_assert(sizeof(SnapshotHeader) == kSectionAlignment,
+              "snapshot header must fill one section");
+
+struct SnapshotSection {
+  uint64_t offset;
+  uint64_t bytes;
+};
+
+struct SnapshotLayout {
+  SnapshotSection sections[4];
+  uint64_t file_size;
+};
+
+uint64_t AlignSection(uint64_t value) {
+  return (value + kSectionAlignment - 1) / kSectionAlignment *
+         kSectionAlignment;
+}
+
+uint32_t GetHeaderWeightSize(const SnapshotHeader &header) {
+  return header.version == 1 ? sizeof(int) : header.weight_size;
+}
+
+SnapshotLayout MakeLayout(const SnapshotHeader &header) {
+  uint64_t n = header.vertices;
+  uint64_t weight_size = GetHeaderWeightSize(header);
+  uint64_t last_section = n;
+  if (header.flags & kSnapshotUpperTriangular) {
+    last_section = n * (n + 1) / 2;
+  } else if (header.flags & kSnapshotHasMatrix) {
+    last_section = n * (uint64_t)header.stride;
+  }
+  uint64_t bytes[4] = {(n + 1) * sizeof(int), header.entries * sizeof(int),
+                       header.entries * weight_size,
+                       last_section * weight_size};
+  SnapshotLayout layout;
+  uint64_t position = sizeof(SnapshotHeader);
+  for (int i = 0; i < 4; i++) {
+    layout.sections[i] = {position, bytes[i]};
+    position = AlignSection(position + bytes[i]);
+  }
+  layout.file_size = position;
+  return layout;
+}
+
+uint32_t LoadWord(const unsigned char *data) {
+  uint32_t word;
+  std::memcpy(&word, data, sizeof(word));
+  return word;
+}
+
+// FNV-1a по 32-битным словам в четыре независимые полосы, неполное последнее
+// слово дополняется нулями
+uint64_t SectionChecksum(const unsigned char *data, uint64_t bytes) {
+  uint64_t lanes[4] = {kFnvOffset, kFnvOffset ^ 1, kFnvOffset ^ 2,
+                       kFnvOffset ^ 3};
+  uint64_t count = bytes / sizeof(uint32_t);
+  uint64_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    for (int lane = 0; lane < 4; lane++) {
+      lanes[lane] = (lanes[lane] ^ LoadWord(data + (i + lane) * 4)) * kFnvPrime;
+    }
+  }
+  for (; i < count; i++) {
+    lanes[0] = (lanes[0] ^ LoadWord(data + i * 4)) * kFnvPrime;
+  }
+  if (bytes % sizeof(uint32_t)) {
+    unsigned char tail[sizeof(uint32_t)] = {};
+    std::memcpy(tail, data + count * 4, bytes % sizeof(uint32_t));
+    lanes[0] = (lanes[0] ^ LoadWord(tail)) * kFnvPrime;
+    count++;
+  }
+  uint64_t result = count;
+  for (int lane = 0; lane < 4; lane++) {
+    result = (result ^ lanes[lane]) * kFnvPrime;
+  }
+  return result;
+}
+
+uint64_t SnapshotChecksum(const unsigned char *const sections[4],
+                          const SnapshotLayout &layout) {
+  uint64_t result = kFnvOffset;
+  for (int i = 0; i < 4; i++) {
+    uint64_t section = SectionChecksum(sections[i], layout.sections[i].bytes);
+    result = (result ^ section) * kFnvPrime;
+  }
+  return result;
+}
+
+}  // namespace
+
+int Graph::ExportGraphToSnapshot(std::string filename) {
+  int error = 0;
+  if (!std::filesystem::exists(filename)) {
+    std::ofstream out(filename, std::ios::binary);
+    if (!out.is_open()) {
+      error = 1;
+    } else {
+      SnapshotHeader header = {};
+      std::memcpy(header.magic, kSnapshotMagic, sizeof(header.magic));
+      header.version = kSnapshotVersion;
+      header.flags = HasMatrix() ? kSnapshotHasMatrix : 0;
+      if (HasMatrix() && layout_ == MatrixLayout::kUpperTriangular) {
+        header.flags |= kSnapshotUpperTriangular;
+      }
+      header.vertices = n_;
+      header.stride = stride_;
+      header.entries = neighbors_.size();
+      header.weight_size = GetWeightSize(weight_type_);
+      SnapshotLayout layout = MakeLayout(header);
+      const unsigned char *sections[4] = {
+          reinterpret_cast<const unsigned char *>(offsets_.data()),
+          reinterpret_cast<const unsigned char *>(neighbors_.data()),
+          weights_.data(), HasMatrix() ? matrix_.data() : loops_.data()};
+      header.file_size = layout.file_size;
+      header.checksum = SnapshotChecksum(sections, layout);
+      out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+      const char padding[kSectionAlignment] = {};
+      for (int i = 0; i < 4; i++) {
+        uint64_t bytes = layout.sections[i].bytes;
+        out.write(reinterpret_cast<const char *>(sections[i]), bytes);
+        out.write(padding, AlignSection(bytes) - bytes);
+      }
+      if (!out) error = 1;
+      out.close();
+    }
+  } else {
+    error = 4;
+  }
+  return error;
+}
+
+int Graph::LoadGraphFromSnapshot(std::string filename) {
+  auto snapshot = std::make_shared<MappedFile>();
+  int error = snapshot->Open(filename);
+  SnapshotHeader header = {};
+  SnapshotLayout layout = {};
+  unsigned char *sections[4] = {};
+  if (!error && snapshot->GetSize() < sizeof(header)) error = 2;
+  if (!error) {
+    std::memcpy(&header, snapshot->GetData(), sizeof(header));
+    uint32_t weight_size = GetHeaderWeightSize(header);
+    if (std::memcmp(header.magic, kSnapshotMagic, sizeof(header.magic)) ||
+        header.version < 1 || header.version > kSnapshotVersion ||
+        (weight_size != 1 && weight_size != 2 && weight_size != 4) ||
+        (header.flags & ~(kSnapshotHasMatrix | kSnapshotUpperTriangular)) ||
+        header.vertices < 0 ||
+        header.vertices > MAX_GRAPH_SIZE || header.entries < 0 ||
+        header.entries > MAX_GRAPH_SIZE || header.stride < 0 ||
+        header.stride > MAX_GRAPH_SIZE) {
+      error = 2;
+    } else if (header.flags & kSnapshotUpperTriangular) {
+      uint64_t cells = (uint64_t)header.vertices * (header.vertices + 1) / 2;
+      if (!(header.flags & kSnapshotHasMatrix) || header.stride != 0 ||
+          cells > snapshot->GetSize() / weight_size) {
+        error = 2;
+      }
+    } else if (header.flags & kSnapshotHasMatrix) {
+      uint64_t cells = (uint64_t)header.vertices * header.stride;
+      if (header.stride < header.vertices ||
+          cells > snapshot->GetSize() / weight_size) {
+        error = 2;
+      }
+    } else if (header.stride != 0) {
+      error = 2;
+    }
+  }
+  if (!error) {
+    layout = MakeLayout(header);
+    if (layout.file_size != header.file_size ||
+        layout.file_size != snapshot->GetSize()) {
+      error = 2;
+    }
+  }
+  if (!error) {
+    for (int i = 0; i < 4; i++) {
+      sections[i] = reinterpret_cast<unsigned char *>(
+          snapshot->GetData() + layout.sections[i].offset);
+    }
+    if (SnapshotChecksum(sections, layout) != header.checksum) error = 2;
+  }
+  if (!error) {
+    error = CheckSnapshotIndex(header.vertices, header.entries,
+                               reinterpret_cast<int *>(sections[0]),
+                               reinterpret_cast<int *>(sections[1]));
+  }
+  if (!error) {
+    ClearData();
+    n_ = header.vertices;
+    weight_type_ = GetWeightTypeOfSize(GetHeaderWeightSize(header));
+    auto int_view = [&](int i) {
+      return aligned_buffer<int>::view(reinterpret_cast<int *>(sections[i]),
+                                       layout.sections[i].bytes / sizeof(int));
+    };
+    auto byte_view = [&](int i) {
+      return aligned_buffer<unsigned char>::view(sections[i],
+                                                 layout.sections[i].bytes);
+    };
+    offsets_ = int_view(0);
+    neighbors_ = int_view(1);
+    weights_ = byte_view(2);
+    if (header.flags & kSnapshotHasMatrix) {
+      stride_ = header.stride;
+      if (header.flags & kSnapshotUpperTriangular) {
+        layout_ = MatrixLayout::kUpperTriangular;
+      }
+      matrix_ = byte_view(3);
+    } else {
+      loops_ = byte_view(3);
+    }
+    snapshot_ = snapshot;
+  }
+  return error;
+}
+
+// Индекс из снимка используется без копирования, поэтому границы строк и
+// номера соседей проверяются, чтобы повреждённый файл не вывел за массивы.
+int Graph::CheckSnapshotIndex(int vertices, int entries, const int *offsets,
+                              const int *neighbors) {
+  int error = 0;
+  if (offsets[0] != 0 || offsets[vertices] != entries) error = 2;
+  for (int v = 0; v < vertices && !error; v++) {
+    if (offsets[v + 1] < offsets[v] || offsets[v + 1] > entries) error = 2;
+    for (int i = offsets[v]; i < offsets[v + 1] && !error; i++) {
+      if (neighbors[i] < 0 || neighbors[i] >= vertices ||
+          (i > offsets[v] && neighbors[i] <= neighbors[i - 1])) {
+        error = 2;
+      }
+    }
+  }
+  return error;
+}
+
+}  // namespace s21
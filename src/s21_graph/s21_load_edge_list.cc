@@ -0,0 +1,152 @@
+#include "s21_graph.h"
+
+#include <algorithm>
+
+#include "s21_parse_text.h"
+
+namespace s21 {
+
+// Формат: необязательная строка "n m" (число вершин и рёбер), затем по
+// строке "u v w" на каждое неориентированное ребро, вершины нумеруются с 1.
+// Строки, начинающиеся с '#' или '%', считаются комментариями. Файл
+// отображается в память и разбирается на месте, как файл матрицы.
+int Graph::LoadGraphFromEdgeList(std::string filename) {
+  MappedFile file;
+  int error = file.Open(filename);
+  if (!error) {
+    ClearData();
+    std::vector<int> edges;  // тройки u, v, w с нумерацией вершин с 0
+    long declared_edges = -1;
+    const char *begin = file.GetData();
+    const char *end = begin + file.GetSize();
+    while (begin != end && !error) {
+      const char *line_end = FindLineEnd(begin, end);
+      error = ParseEdgeListLine(begin, line_end, &edges, &declared_edges);
+      begin = line_end == end ? end : line_end + 1;
+    }
+    if (!error && declared_edges >= 0 &&
+        declared_edges != (long)edges.size() / 3) {
+      error = 2;
+    }
+    if (!error) error = BuildSparseIndex(edges);
+    if (error) ClearData();
+  }
+  return error;
+}
+
+int Graph::ParseEdgeListLine(const char *begin, const char *end,
+                             std::vector<int> *edges, long *declared_edges) {
+  int error = 0;
+  int value[3] = {0, 0, 0};
+  int count = 0;
+  begin = SkipBlanks(begin, end);
+  if (begin == end || *begin == '#' || *begin == '%') {
+    return error;
+  }
+  while (begin != end && !error) {
+    if (count == 3) {
+      error = 2;
+    } else {
+      begin = ParseCell(begin, end, &value[count]);
+      if (!begin) {
+        error = 2;
+      } else {
+        count++;
+        begin = SkipBlanks(begin, end);
+      }
+    }
+  }
+  if (!error && count == 2 && edges->empty() && *declared_edges < 0) {
+    n_ = value[0];
+    *declared_edges = value[1];
+    edges->reserve(std::min(value[1], 1 << 24) * 3L);
+  } else if (!error && count == 3) {
+    if (value[0] == 0 || value[1] == 0 || value[2] == 0) error = 2;
+    if (!error && *declared_edges >= 0 && (value[0] > n_ || value[1] > n_)) {
+      error = 2;
+    }
+    if (!error) {
+      edges->push_back(value[0] - 1);
+      edges->push_back(value[1] - 1);
+      edges->push_back(value[2]);
+    }
+  } else {
+    error = 2;
+  }
+  return error;
+}
+
+int Graph::BuildSparseIndex(const std::vector<int> &edges) {
+  long edges_count = edges.size() / 3;
+  int max_weight = 0;
+  for (long e = 0; e < edges_count; e++) {
+    n_ = std::max(n_, std::max(edges[3 * e], edges[3 * e + 1]) + 1);
+    max_weight = std::max(max_weight, edges[3 * e + 2]);
+  }
+  stride_ = 0;
+  weight_type_ = GetNarrowestWeightType(max_weight);
+  std::vector<int> loops(n_, 0);
+  std::vector<long> counts(n_ + 1, 0);
+  for (long e = 0; e < edges_count; e++) {
+    int u = edges[3 * e], v = edges[3 * e + 1], w = edges[3 * e + 2];
+    if (u == v) {
+      loops[u] = loops[u] ? std::min(loops[u], w) : w;
+    } else {
+      counts[u + 1]++;
+      counts[v + 1]++;
+    }
+  }
+  for (int v = 0; v < n_; v++) counts[v + 1] += counts[v];
+  if (counts[n_] > MAX_GRAPH_SIZE) return 2;
+
+  std::vector<std::pair<int, int>> adjacency(counts[n_]);
+  std::vector<long> cursor(counts.begin(), counts.end() - 1);
+  for (long e = 0; e < edges_count; e++) {
+    int u = edges[3 * e], v = edges[3 * e + 1], w = edges[3 * e + 2];
+    if (u != v) {
+      adjacency[cursor[u]++] = {v, w};
+      adjacency[cursor[v]++] = {u, w};
+    }
+  }
+
+  // Повторные рёбра между одной парой вершин сливаются в самое лёгкое
+  offsets_.assign(n_ + 1);
+  for (int v = 0; v < n_; v++) {
+    auto begin = adjacency.begin() + counts[v];
+    auto end = adjacency.begin() + counts[v + 1];
+    std::sort(begin, end);
+    int unique = 0;
+    for (auto it = begin; it != end; ++it) {
+      unique += (it == begin || it->first != (it - 1)->first);
+    }
+    offsets_[v + 1] = offsets_[v] + unique;
+  }
+  int error = 0;
+  int weights = 0;
+  neighbors_.assign(offsets_[n_]);
+  weights_.assign((size_t)offsets_[n_] * GetWeightSize(weight_type_));
+  loops_.assign((size_t)n_ * GetWeightSize(weight_type_));
+  VisitWeightType(weight_type_, [&](auto zero) {
+    using W = decltype(zero);
+    W *typed_weights = reinterpret_cast<W *>(weights_.data());
+    std::copy(loops.begin(), loops.end(), reinterpret_cast<W *>(loops_.data()));
+    for (int v = 0; v < n_; v++) {
+      auto begin = adjacency.begin() + counts[v];
+      auto end = adjacency.begin() + counts[v + 1];
+      int position = offsets_[v];
+      for (auto it = begin; it != end; ++it) {
+        if (it == begin || it->first != (it - 1)->first) {
+          neighbors_[position] = it->first;
+          typed_weights[position++] = it->second;
+          if (it->second != 1) weights = 1;
+        }
+      }
+      if (loops[v] > 1) weights = 1;
+      if (offsets_[v + 1] == offsets_[v] && !loops[v]) error = 2;
+    }
+  });
+  if (!error && !weights) error = 3;
+  return error;
+}
+
+}  // namespace s21
\ No newline at end of file
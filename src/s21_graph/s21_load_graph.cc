@@ -1,80 +1,264 @@
 #include "s21_graph.h"
 
+#include <algorithm>
+#include <limits>
+
+#include "s21_parse_text.h"
+
 namespace s21 {
 
-int Graph::LoadGraphFromFile(std::string filename) {
-  int error = 0;
-  std::filesystem::path path_to_file = filename;
-  std::ifstream file(filename);
-  if (!file.is_open() || !std::filesystem::is_regular_file(path_to_file)) {
-    error = 1;
-  } else {
+// Файл отображается в память и разбирается на месте: числа читаются
+// std::from_chars прямо в строки матрицы, без промежуточных строк и потоков.
+// Веса хранятся в самом узком вмещающем их типе: матрица заводится с uint8_t
+// и расширяется, когда встречается больший вес.
+int Graph::LoadGraphFromFile(std::string filename, LoadOptions options) {
+  MappedFile file;
+  int error = file.Open(filename);
+  if (!error) {
     ClearData();
-    int current_line = 0;
-    std::string line;
-    while (std::getline(file, line)) {
-      std::stringstream ss(line);
-      std::string word;
-      std::vector<std::string> line_data;
-      while (ss >> word) {
-        line_data.push_back(word);
-      }
-      LineHandle(line_data, &current_line, &error);
-      if (error) break;
+    layout_ = options.layout;
+    ThreadPool pool(options.threads);
+    const char *begin = file.GetData();
+    const char *end = begin + file.GetSize();
+    ParseStats stats;
+    error = ParseMatrixHead(&begin, end, &stats);
+    if (!error && n_ > 1) error = ParseMatrixRows(begin, end, &pool, &stats);
+    if (!error) error = CheckDirWeight(stats, &pool);
+    if (!error) {
+      BuildAdjacencyIndex();
+    } else {
+      ClearData();
     }
-    if (!error) error = CheckDirWeight();
-    file.close();
   }
   return error;
 }
 
-void Graph::LineHandle(std::vector<std::string> line_data, int *current_line,
-                       int *error) {
-  if (*current_line == 0) {
-    if (line_data.size() == 1) {
-      try {
-        long unsigned int value = std::stoul(line_data[0]);
+// Пустые строки и строка из одного числа (размер графа) до матрицы
+// пропускаются, первая строка из нескольких чисел задаёт размер матрицы и
+// разбирается здесь же; *begin сдвигается на следующую за ней строку.
+int Graph::ParseMatrixHead(const char **begin, const char *end,
+                           ParseStats *stats) {
+  int error = 0;
+  bool found = false;
+  while (*begin != end && !error && !found) {
+    const char *line_end = FindLineEnd(*begin, end);
+    long size = CountTokens(*begin, line_end);
+    if (size == 1) {
+      int value = 0;
+      if (!ParseCell(SkipBlanks(*begin, line_end), line_end, &value)) {
+        error = 2;
+      } else {
         n_ = value;
-      } catch (...) {
-        *error = 2;
       }
-    } else if (line_data.size() != 0 && line_data.size() <= MAX_GRAPH_SIZE) {
-      n_ = line_data.size();
-      matrix_.resize(line_data.size(), std::vector<int>(0, 0));
-      *error = PushVal(line_data, *current_line);
-      *current_line = *current_line + 1;
-    } else if (line_data.size() != 0) {
-      *error = 2;
+    } else if (size > MAX_GRAPH_SIZE) {
+      error = 2;
+    } else if (size != 0) {
+      // До построения индекса offsets_[row + 1] хранит число рёбер строки
+      AllocateMatrix(size, WeightType::kUint8);
+      offsets_.assign(n_ + 1);
+      error = ParseMatrixRow(*begin, line_end, 0, 0, stats);
+      if (!error && stats->max_weight > GetWeightLimit(weight_type_)) {
+        WidenMatrix(GetNarrowestWeightType(stats->max_weight));
+        error = ParseMatrixRow(*begin, line_end, 0, 0, stats);
+      }
+      found = true;
     }
-  } else {
-    if (line_data.size() <= MAX_GRAPH_SIZE) {
-      int size = line_data.size();
-      if (size == GetVerticesCount() && *current_line < GetVerticesCount()) {
-        *error = PushVal(line_data, *current_line);
-        *current_line = *current_line + 1;
-      } else if (size != GetVerticesCount() &&
-                 *current_line < GetVerticesCount()) {
-        *error = 2;
+    *begin = line_end == end ? end : line_end + 1;
+  }
+  if (!error && !found && n_ > 0) error = 2;
+  return error;
+}
+
+// Строки после первой разбираются одним куском или, если потоков несколько,
+// кусками по границам строк: потоки сначала считают строки в своих кусках,
+// чтобы узнать номер первой строки каждого, затем разбирают их прямо в
+// матрицу. Кусок, встретивший не вмещающийся в матрицу вес, останавливается
+// на этой строке; когда все куски остановились, матрица расширяется и они
+// продолжают с места остановки. При верхнетреугольном хранении кусок сверяет
+// веса под диагональю только со строками, разобранными им самим, а начала
+// строк, отражённые в строки предыдущих кусков, сверяются после разбора.
+int Graph::ParseMatrixRows(const char *begin, const char *end,
+                           ThreadPool *pool, ParseStats *stats) {
+  int chunks = pool->GetThreadsCount() == 1 ? 1 : pool->GetThreadsCount() * 4;
+  std::vector<const char *> bounds(chunks + 1, end);
+  bounds[0] = begin;
+  for (int k = 1; k < chunks; k++) {
+    const char *target =
+        std::max(bounds[k - 1], begin + (end - begin) / chunks * k);
+    if (target != begin && target[-1] != '\n') {
+      target = FindLineEnd(target, end);
+      if (target != end) target++;
+    }
+    bounds[k] = target;
+  }
+
+  std::vector<long> lines(chunks + 1, 0);
+  if (chunks > 1) {
+    pool->ParallelFor(chunks, [&](int k, int) {
+      long count = std::count(bounds[k], bounds[k + 1], '\n');
+      if (bounds[k + 1] == end && bounds[k] != end && end[-1] != '\n') count++;
+      lines[k + 1] = count;
+    });
+    for (int k = 0; k < chunks; k++) lines[k + 1] += lines[k];
+  }
+
+  std::vector<const char *> cursors(bounds.begin(), bounds.end() - 1);
+  std::vector<int> first_rows(chunks);
+  std::vector<int> rows(chunks);
+  std::vector<int> errors(chunks, 0);
+  std::vector<ParseStats> chunk_stats(chunks);
+  for (int k = 0; k < chunks; k++) {
+    first_rows[k] = std::min<long>(1 + lines[k], n_);
+    rows[k] = first_rows[k];
+  }
+  bool widened = true;
+  while (widened) {
+    pool->ParallelFor(chunks, [&](int k, int) {
+      if (!errors[k]) {
+        int mirror_from = k == 0 ? 0 : first_rows[k];
+        errors[k] = ParseMatrixChunk(&cursors[k], bounds[k + 1], mirror_from,
+                                     &rows[k], &chunk_stats[k]);
       }
-    } else {
-      *error = 2;
+    });
+    for (int k = 0; k < chunks; k++) {
+      int max_weight = chunk_stats[k].max_weight;
+      stats->max_weight = std::max(stats->max_weight, max_weight);
     }
+    widened = stats->max_weight > GetWeightLimit(weight_type_) &&
+              std::count(errors.begin(), errors.end(), 0) == chunks;
+    if (widened) WidenMatrix(GetNarrowestWeightType(stats->max_weight));
   }
+
+  int error = 0;
+  long rows_read = 0;
+  for (int k = 0; k < chunks; k++) {
+    if (errors[k]) error = 2;
+    if (chunk_stats[k].asymmetric) stats->asymmetric = true;
+    rows_read += rows[k] - first_rows[k];
+  }
+  if (!error && 1 + rows_read < n_) error = 2;
+  if (!error && layout_ == MatrixLayout::kUpperTriangular && chunks > 1) {
+    std::vector<char> asymmetric(chunks, false);
+    pool->ParallelFor(chunks - 1, [&](int k, int) {
+      asymmetric[k + 1] = CheckMirroredPrefix(bounds[k + 1], bounds[k + 2],
+                                              first_rows[k + 1], rows[k + 1]);
+    });
+    for (int k = 0; k < chunks; k++) {
+      if (asymmetric[k]) stats->asymmetric = true;
+    }
+  }
+  return error;
 }
 
-int Graph::PushVal(std::vector<std::string> line_data, int row) {
+// Разбирает строки [*begin, end) как строки матрицы, начиная с *row, строки
+// после последней строки матрицы не читаются. На строке с весом больше, чем
+// вмещает матрица, останавливается: *begin и *row указывают на эту строку.
+// Строки выше mirror_from для сверки симметричности ещё могут быть не готовы.
+int Graph::ParseMatrixChunk(const char **begin, const char *end,
+                            int mirror_from, int *row, ParseStats *stats) {
   int error = 0;
-  int size = line_data.size();
-  for (int i = 0; i < size; ++i) {
-    try {
-      long unsigned int value = std::stoul(line_data[i]);
-      matrix_[row].push_back(value);
-    } catch (...) {
+  const int limit = GetWeightLimit(weight_type_);
+  while (*begin != end && *row < n_ && !error && stats->max_weight <= limit) {
+    const char *line_end = FindLineEnd(*begin, end);
+    error = ParseMatrixRow(*begin, line_end, *row, mirror_from, stats);
+    if (!error && stats->max_weight <= limit) {
+      (*row)++;
+      *begin = line_end == end ? end : line_end + 1;
+    }
+  }
+  return error;
+}
+
+int Graph::ParseMatrixRow(const char *begin, const char *end, int row,
+                          int mirror_from, ParseStats *stats) {
+  return VisitWeightType(weight_type_, [&](auto zero) {
+    return ParseMatrixRow<decltype(zero)>(begin, end, row, mirror_from, stats);
+  });
+}
+
+// Вместе с разбором для строки считается число рёбер (без петли), оно
+// сразу записывается в offsets_, и обновляется наибольший вес. Строка с
+// весом, не вмещающимся в W, не дочитывается. При верхнетреугольном
+// хранении веса строки левее диагонали не записываются, а сверяются с уже
+// разобранными строками начиная с mirror_from.
+template <typename W>
+int Graph::ParseMatrixRow(const char *begin, const char *end, int row,
+                          int mirror_from, ParseStats *stats) {
+  int error = 0;
+  W *values = GetMutableRow<W>(row);
+  const W *matrix = GetMatrixRow<W>(0);
+  const int limit = std::numeric_limits<W>::max();
+  const int stored_from = layout_ == MatrixLayout::kFull ? 0 : row;
+  size_t mirror = row;  // место веса (count, row) при count < row
+  int count = 0;
+  int degree = 0;
+  int max_value = 0;
+  bool asymmetric = false;
+  begin = SkipBlanks(begin, end);
+  while (begin != end && !error && max_value <= limit) {
+    if (count == n_) {
+      error = 2;
+    } else {
+      int value = 0;
+      begin = ParseCell(begin, end, &value);
+      if (!begin) {
+        error = 2;
+      } else {
+        if (count >= stored_from) {
+          values[count] = value;
+        } else {
+          if (count >= mirror_from && matrix[mirror] != value) {
+            asymmetric = true;
+          }
+          mirror += n_ - count - 1;
+        }
+        count++;
+        degree += (value != 0);
+        max_value = std::max(max_value, value);
+        begin = SkipBlanks(begin, end);
+      }
+    }
+  }
+  stats->max_weight = std::max(stats->max_weight, max_value);
+  if (asymmetric) stats->asymmetric = true;
+  if (!error && max_value <= limit) {
+    if (count != n_) {
       error = 2;
-      break;
+    } else {
+      offsets_[row + 1] = degree - (values[row] != 0);
     }
   }
   return error;
 }
 
+bool Graph::CheckMirroredPrefix(const char *begin, const char *end,
+                               int first_row, int last_row) {
+  return VisitWeightType(weight_type_, [&](auto zero) {
+    return CheckMirroredPrefix<decltype(zero)>(begin, end, first_row,
+                                               last_row);
+  });
+}
+
+// Сверяет первые first_row весов строк [first_row, last_row), уже
+// проверенных разбором, с отражёнными весами строк над ними
+template <typename W>
+bool Graph::CheckMirroredPrefix(const char *begin, const char *end,
+                               int first_row, int last_row) {
+  const W *matrix = GetMatrixRow<W>(0);
+  bool asymmetric = false;
+  for (int row = first_row; row < last_row && !asymmetric; row++) {
+    const char *line_end = FindLineEnd(begin, end);
+    const char *cell = SkipBlanks(begin, line_end);
+    size_t mirror = row;
+    for (int col = 0; col < first_row && !asymmetric; col++) {
+      int value = 0;
+      cell = SkipBlanks(ParseCell(cell, line_end, &value), line_end);
+      asymmetric = matrix[mirror] != value;
+      mirror += n_ - col - 1;
+    }
+    begin = line_end == end ? end : line_end + 1;
+  }
+  return asymmetric;
+}
+
 }  // namespace s21
\ No newline at end of file
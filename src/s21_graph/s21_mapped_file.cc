@@ -0,0 +1,63 @@
+#include "s21_mapped_file.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace s21 {
+
+int MappedFile::Open(const std::string &filename) {
+  int error = 0;
+  Close();
+  int fd = open(filename.c_str(), O_RDONLY);
+  struct stat info;
+  if (fd < 0 || fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+    error = 1;
+  } else if (info.st_size > 0) {
+    void *data = mmap(nullptr, info.st_size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      error = 1;
+    } else {
+      data_ = static_cast<char *>(data);
+      size_ = info.st_size;
+    }
+  }
+  if (fd >= 0) close(fd);
+  return error;
+}
+
+int MappedFile::Create(const std::string &filename, size_t size) {
+  int error = 0;
+  Close();
+  int fd = open(filename.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+  if (fd < 0) {
+    error = errno == EEXIST ? 4 : 1;
+  } else if (ftruncate(fd, size) != 0) {
+    error = 1;
+  } else if (size > 0) {
+    void *data =
+        mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+      error = 1;
+    } else {
+      data_ = static_cast<char *>(data);
+      size_ = size;
+      shared_ = true;
+    }
+  }
+  if (fd >= 0) close(fd);
+  if (fd >= 0 && error) unlink(filename.c_str());
+  return error;
+}
+
+void MappedFile::Close() {
+  if (data_) munmap(data_, size_);
+  data_ = nullptr;
+  size_ = 0;
+  shared_ = false;
+}
+
+}  // namespace s21
\ No newline at end of file
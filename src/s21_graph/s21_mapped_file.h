@@ -0,0 +1,36 @@
+#ifndef A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_S21_MAPPED_FILE_H
+#define A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_S21_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+namespace s21 {
+
+// File mapped into memory with mmap. Pages of a file mapped by Open() are
+// private copy-on-write, so writing through GetData() never reaches the
+// file; a file made by Create() is shared and receives every write.
+class MappedFile {
+ public:
+  MappedFile() : data_(nullptr), size_(0), shared_(false) {}
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  ~MappedFile() { Close(); }
+  int Open(const std::string &filename);
+  // Creates a new file of size bytes filled with zeros and maps it for
+  // writing; returns 4 if the file already exists and 1 on other errors
+  int Create(const std::string &filename, size_t size);
+  void Close();
+  char *GetData() const { return data_; }
+  size_t GetSize() const { return size_; }
+  // True for a file made by Create(), whose pages are written back
+  bool IsShared() const { return shared_; }
+
+ private:
+  char *data_;
+  size_t size_;
+  bool shared_;
+};
+
+}  // namespace s21
+
+#endif  // A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_S21_MAPPED_FILE_H
\ No newline at end of file
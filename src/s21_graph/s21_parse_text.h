@@ -0,0 +1,59 @@
+#ifndef A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_S21_PARSE_TEXT_H
+#define A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_S21_PARSE_TEXT_H
+
+#include <charconv>
+#include <cstring>
+
+#include "s21_graph.h"
+
+namespace s21 {
+
+// Разбор текстовых файлов графа на месте, по отображённому в память файлу:
+// строки находятся memchr, числа читаются std::from_chars без промежуточных
+// строк и потоков. Общие для загрузчиков матрицы и списка рёбер.
+
+inline bool IsBlank(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+inline const char *SkipBlanks(const char *begin, const char *end) {
+  while (begin != end && IsBlank(*begin)) ++begin;
+  return begin;
+}
+
+inline const char *FindLineEnd(const char *begin, const char *end) {
+  const void *found = std::memchr(begin, '\n', end - begin);
+  return found ? static_cast<const char *>(found) : end;
+}
+
+// Разбирает одно неотрицательное число до пробела или конца строки. Как и
+// прежний std::stoul, принимает один знак перед числом: «+3» и «-0», но
+// отрицательные числа кроме нуля — ошибка формата.
+inline const char *ParseCell(const char *begin, const char *end, int *value) {
+  bool negative = begin != end && *begin == '-';
+  if (begin != end && (*begin == '+' || negative)) ++begin;
+  unsigned long number = 0;
+  auto [ptr, ec] = std::from_chars(begin, end, number);
+  if (ec != std::errc() || (ptr != end && !IsBlank(*ptr)) ||
+      number > MAX_GRAPH_SIZE || (negative && number != 0)) {
+    ptr = nullptr;
+  } else {
+    *value = number;
+  }
+  return ptr;
+}
+
+inline long CountTokens(const char *begin, const char *end) {
+  long count = 0;
+  begin = SkipBlanks(begin, end);
+  while (begin != end) {
+    count++;
+    while (begin != end && !IsBlank(*begin)) ++begin;
+    begin = SkipBlanks(begin, end);
+  }
+  return count;
+}
+
+}  // namespace s21
+
+#endif  // A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_S21_PARSE_TEXT_H
\ No newline at end of file
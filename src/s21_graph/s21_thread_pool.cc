@@ -0,0 +1,68 @@
+#include "s21_thread_pool.h"
+
+namespace s21 {
+
+ThreadPool::ThreadPool(int threads)
+    : task_(nullptr), count_(0), next_(0), generation_(0), busy_(0),
+      stop_(false) {
+  if (threads <= 0) threads = GetHardwareThreads();
+  for (int i = 1; i < threads; i++) {
+    workers_.emplace_back(&ThreadPool::WorkerLoop, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  start_.notify_all();
+  for (auto &worker : workers_) worker.join();
+}
+
+int ThreadPool::GetHardwareThreads() {
+  int threads = std::thread::hardware_concurrency();
+  return threads > 0 ? threads : 1;
+}
+
+void ThreadPool::ParallelFor(int count,
+                             const std::function<void(int, int)> &task) {
+  if (workers_.empty() || count <= 1) {
+    for (int i = 0; i < count; i++) task(i, 0);
+  } else {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      task_ = &task;
+      count_ = count;
+      next_ = 0;
+      busy_ = workers_.size();
+      generation_++;
+    }
+    start_.notify_all();
+    RunTasks(0);
+    std::unique_lock<std::mutex> lock(mutex_);
+    finish_.wait(lock, [this] { return busy_ == 0; });
+    task_ = nullptr;
+  }
+}
+
+void ThreadPool::WorkerLoop(int thread) {
+  int seen = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      start_.wait(lock, [&] { return stop_ || generation_ != seen; });
+      if (stop_) break;
+      seen = generation_;
+    }
+    RunTasks(thread);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--busy_ == 0) finish_.notify_one();
+  }
+}
+
+void ThreadPool::RunTasks(int thread) {
+  for (int i = next_++; i < count_; i = next_++) (*task_)(i, thread);
+}
+
+}  // namespace s21
\ No newline at end of file
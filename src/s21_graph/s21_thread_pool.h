@@ -0,0 +1,46 @@
+#ifndef A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_S21_THREAD_POOL_H
+#define A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_S21_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+
+// Fixed set of worker threads for data-parallel loops. The calling thread
+// takes part in every loop as thread 0, so a pool of one thread runs the
+// loop inline without starting any workers.
+class ThreadPool {
+ public:
+  // threads <= 0 means one thread per hardware core
+  explicit ThreadPool(int threads = 0);
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  ~ThreadPool();
+  int GetThreadsCount() const { return workers_.size() + 1; }
+  // Calls task(index, thread) for every index in [0, count) and returns when
+  // all calls are finished; thread is in [0, GetThreadsCount())
+  void ParallelFor(int count, const std::function<void(int, int)> &task);
+  static int GetHardwareThreads();
+
+ private:
+  void WorkerLoop(int thread);
+  void RunTasks(int thread);
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable start_;
+  std::condition_variable finish_;
+  const std::function<void(int, int)> *task_;
+  int count_;
+  std::atomic<int> next_;
+  int generation_;
+  int busy_;
+  bool stop_;
+};
+
+}  // namespace s21
+
+#endif  // A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_S21_THREAD_POOL_H
\ No newline at end of file
@@ -0,0 +1,69 @@
+#ifndef A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_S21_WEIGHT_TYPE_H
+#define A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_S21_WEIGHT_TYPE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace s21 {
+
+// Type the graph stores its edge weights in. Loaders pick the narrowest one
+// that holds the largest weight of the graph; sums of weights are always
+// accumulated in int or wider by the algorithms.
+enum class WeightType { kUint8, kUint16, kInt32 };
+
+// Calls f with a value-initialized object of the C++ type matching type, so
+// that generic code runs with the weight type known at compile time.
+template <typename F>
+decltype(auto) VisitWeightType(WeightType type, F &&f) {
+  switch (type) {
+    case WeightType::kUint8:
+      return f(uint8_t());
+    case WeightType::kUint16:
+      return f(uint16_t());
+    default:
+      return f(int32_t());
+  }
+}
+
+inline int GetWeightSize(WeightType type) {
+  return VisitWeightType(type, [](auto zero) { return (int)sizeof(zero); });
+}
+
+inline int GetWeightLimit(WeightType type) {
+  return VisitWeightType(type, [](auto zero) {
+    return (int)std::numeric_limits<decltype(zero)>::max();
+  });
+}
+
+inline WeightType GetNarrowestWeightType(int max_weight) {
+  WeightType type = WeightType::kInt32;
+  if (max_weight <= GetWeightLimit(WeightType::kUint8)) {
+    type = WeightType::kUint8;
+  } else if (max_weight <= GetWeightLimit(WeightType::kUint16)) {
+    type = WeightType::kUint16;
+  }
+  return type;
+}
+
+// Type whose weights take size bytes, size is 1, 2 or 4
+inline WeightType GetWeightTypeOfSize(int size) {
+  WeightType type = WeightType::kInt32;
+  if (size == 1) {
+    type = WeightType::kUint8;
+  } else if (size == 2) {
+    type = WeightType::kUint16;
+  }
+  return type;
+}
+
+// Weight number index of an array of weights stored as type
+inline int ReadWeight(const void *data, size_t index, WeightType type) {
+  return VisitWeightType(type, [&](auto zero) {
+    return (int)static_cast<const decltype(zero) *>(data)[index];
+  });
+}
+
+}  // namespace s21
+
+#endif  // A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_S21_WEIGHT_TYPE_H
\ No newline at end of file
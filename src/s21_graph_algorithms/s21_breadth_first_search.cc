@@ -0,0 +1,210 @@
+#include "s21_graph_algorithms.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace s21 {
+
+namespace {
+
+// Пороги переключения направления (Beamer и др.): снизу вверх, когда у
+// фронта рёбер больше 1/14 рёбер непосещённых вершин, обратно сверху вниз,
+// когда во фронте меньше 1/24 вершин графа
+const long long kBottomUpEdgesRatio = 14;
+const long long kTopDownVerticesRatio = 24;
+
+// Множество вершин (нумерация с 0) по биту на вершину
+using Bitmap = std::vector<uint64_t>;
+
+bool TestBit(const Bitmap &bitmap, int vertex) {
+  return (bitmap[vertex >> 6] >> (vertex & 63)) & 1;
+}
+
+void SetBit(Bitmap &bitmap, int vertex) {
+  bitmap[vertex >> 6] |= uint64_t(1) << (vertex & 63);
+}
+
+int GetDegree(const AdjacencyIndex &index, int vertex) {
+  return index.offsets[vertex + 1] - index.offsets[vertex];
+}
+
+// Шаг сверху вниз: вершины фронта order[begin, end) отдают непосещённых
+// соседей следующему уровню, соседи обходятся от старших к младшим, как в
+// BreadthFirstSearch
+void ExpandTopDown(const AdjacencyIndex &index, int begin, int end,
+                   int level, Bitmap &visited, BreadthFirstTree &tree) {
+  for (int i = begin; i < end; ++i) {
+    int vertex = tree.order[i];
+    for (int e = index.offsets[vertex + 1] - 1; e >= index.offsets[vertex];
+         --e) {
+      int neighbor = index.neighbors[e];
+      if (!TestBit(visited, neighbor)) {
+        SetBit(visited, neighbor);
+        tree.level[neighbor] = level;
+        tree.parent[neighbor] = vertex + 1;
+        tree.order.push_back(neighbor);
+      }
+    }
+  }
+}
+
+// Шаг снизу вверх: каждая непосещённая вершина ищет среди соседей вершину
+// фронта и останавливается на первой найденной. Целиком посещённые слова
+// битовой карты пропускаются без просмотра вершин.
+void ExpandBottomUp(const AdjacencyIndex &index, const Bitmap &frontier,
+                    int level, Bitmap &visited, BreadthFirstTree &tree) {
+  for (size_t word = 0; word < visited.size(); ++word) {
+    uint64_t unvisited = ~visited[word];
+    while (unvisited) {
+      int vertex = word * 64 + __builtin_ctzll(unvisited);
+      unvisited &= unvisited - 1;
+      if (vertex >= index.vertices) break;
+      for (int e = index.offsets[vertex]; e < index.offsets[vertex + 1]; ++e) {
+        int neighbor = index.neighbors[e];
+        if (TestBit(frontier, neighbor)) {
+          SetBit(visited, vertex);
+          tree.level[vertex] = level;
+          tree.parent[vertex] = neighbor + 1;
+          tree.order.push_back(vertex);
+          break;
+        }
+      }
+    }
+  }
+}
+
+// Обход уровнями от source (нумерация с 0). Вершины уровня лежат в order
+// подряд, поэтому фронт — это отрезок order; для шага снизу вверх он
+// переносится в битовую карту.
+BreadthFirstTree FindBreadthFirstTree(const AdjacencyIndex &index, int source,
+                                      bool optimize_direction) {
+  int n = index.vertices;
+  BreadthFirstTree tree;
+  tree.order.reserve(n);
+  tree.level.assign(n, -1);
+  tree.parent.assign(n, 0);
+  Bitmap visited((n + 63) / 64, 0);
+  Bitmap frontier;
+  SetBit(visited, source);
+  tree.level[source] = 0;
+  tree.order.push_back(source);
+  long long frontier_edges = GetDegree(index, source);
+  long long unexplored_edges = index.offsets[n] - frontier_edges;
+  bool bottom_up = false;
+  int begin = 0;
+  int end = 1;
+  for (int level = 1; begin < end; ++level) {
+    if (optimize_direction && !bottom_up) {
+      bottom_up = frontier_edges * kBottomUpEdgesRatio > unexplored_edges;
+    } else if (bottom_up) {
+      bottom_up = (long long)(end - begin) * kTopDownVerticesRatio >= n;
+    }
+    if (bottom_up) {
+      frontier.assign(visited.size(), 0);
+      for (int i = begin; i < end; ++i) SetBit(frontier, tree.order[i]);
+      ExpandBottomUp(index, frontier, level, visited, tree);
+    } else {
+      ExpandTopDown(index, begin, end, level, visited, tree);
+    }
+    begin = end;
+    end = tree.order.size();
+    frontier_edges = 0;
+    for (int i = begin; i < end; ++i) {
+      frontier_edges += GetDegree(index, tree.order[i]);
+    }
+    unexplored_edges -= frontier_edges;
+  }
+  for (int &vertex : tree.order) ++vertex;
+  return tree;
+}
+
+// Параллельный обход уровнями: фронт order[begin, end) делится на куски по
+// kParallelChunk вершин, которые разбирают потоки pool. Соседа забирает тот
+// поток, чей compare-and-swap первым поменял его уровень с -1, и кладёт в
+// свой буфер следующего уровня; буферы затем копируются в конец order каждый
+// в свой отрезок, без блокировок.
+const int kParallelChunk = 256;
+
+BreadthFirstTree FindBreadthFirstTreeParallel(const AdjacencyIndex &index,
+                                              int source, ThreadPool *pool) {
+  int n = index.vertices;
+  int threads = pool->GetThreadsCount();
+  BreadthFirstTree tree;
+  tree.order.reserve(n);
+  tree.level.assign(n, -1);
+  tree.parent.assign(n, 0);
+  tree.level[source] = 0;
+  tree.order.push_back(source);
+  std::vector<std::vector<int>> next(threads);
+  std::vector<size_t> offsets(threads + 1);
+  size_t begin = 0;
+  size_t end = 1;
+  for (int level = 1; begin < end; ++level) {
+    int chunks = (end - begin + kParallelChunk - 1) / kParallelChunk;
+    auto expand = [&](int chunk, int thread) {
+      size_t first = begin + (size_t)chunk * kParallelChunk;
+      size_t last = std::min(first + kParallelChunk, end);
+      for (size_t i = first; i < last; ++i) {
+        int vertex = tree.order[i];
+        for (int e = index.offsets[vertex]; e < index.offsets[vertex + 1];
+             ++e) {
+          int neighbor = index.neighbors[e];
+          int *claim = &tree.level[neighbor];
+          int unvisited = -1;
+          if (__atomic_load_n(claim, __ATOMIC_RELAXED) == -1 &&
+              __atomic_compare_exchange_n(claim, &unvisited, level, false,
+                                          __ATOMIC_RELAXED,
+                                          __ATOMIC_RELAXED)) {
+            tree.parent[neighbor] = vertex + 1;
+            next[thread].push_back(neighbor);
+          }
+        }
+      }
+    };
+    auto copy = [&](int t, int) {
+      std::copy(next[t].begin(), next[t].end(),
+                tree.order.begin() + offsets[t]);
+      next[t].clear();
+    };
+    // Узкий уровень быстрее разобрать в вызывающем потоке, чем будить пул
+    if (chunks > 1) {
+      pool->ParallelFor(chunks, expand);
+    } else {
+      expand(0, 0);
+    }
+    offsets[0] = end;
+    for (int t = 0; t < threads; ++t) {
+      offsets[t + 1] = offsets[t] + next[t].size();
+    }
+    tree.order.resize(offsets[threads]);
+    if (chunks > 1) {
+      pool->ParallelFor(threads, copy);
+    } else {
+      copy(0, 0);
+    }
+    begin = end;
+    end = tree.order.size();
+  }
+  for (int &vertex : tree.order) ++vertex;
+  return tree;
+}
+
+}  // namespace
+
+BreadthFirstTree GraphAlgorithms::BreadthFirstSearch(Graph &graph,
+                                                     int start_vertex,
+                                                     TraversalMode mode,
+                                                     int threads) {
+  if (start_vertex > graph.GetVerticesCount() || start_vertex < 1) {
+    return BreadthFirstTree();
+  }
+  if (mode == TraversalMode::kParallel) {
+    ThreadPool pool(threads);
+    return FindBreadthFirstTreeParallel(graph.GetAdjacencyIndex(),
+                                        start_vertex - 1, &pool);
+  }
+  return FindBreadthFirstTree(graph.GetAdjacencyIndex(), start_vertex - 1,
+                              mode == TraversalMode::kDirectionOptimizing);
+}
+
+}  // namespace s21
\ No newline at end of file
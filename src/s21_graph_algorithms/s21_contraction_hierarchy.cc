@@ -0,0 +1,368 @@
+#include "s21_contraction_hierarchy.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "../s21_graph/s21_binary_file.h"
+
+namespace s21 {
+
+namespace {
+
+// Файл иерархии: заголовок, затем массивы ranks (n), offsets (n + 1),
+// neighbors и middles (по arcs int) и weights (arcs весов размера
+// weight_size). Граф, для которого построена иерархия, узнаётся по его
+// отпечатку.
+const char kHierarchyMagic[8] = {'S', '2', '1', 'C', 'H', 'I', 'E', 'R'};
+const uint32_t kHierarchyVersion = 1;
+
+struct HierarchyHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t weight_size;
+  int64_t vertices;
+  int64_t arcs;
+  uint64_t fingerprint;  // отпечаток графа
+  uint64_t checksum;     // по всем массивам
+};
+
+}  // namespace
+
+void ContractionHierarchy::Build(const Graph &graph) {
+  Clear();
+  AdjacencyIndex index = graph.GetAdjacencyIndex();
+  int n = index.vertices;
+  ArcLists arcs(n);
+  VisitWeightType(index.weight_type, [&](auto zero) {
+    const auto *weights = index.GetWeights<decltype(zero)>();
+    for (int v = 0; v < n; v++) {
+      for (int e = index.offsets[v]; e < index.offsets[v + 1]; e++) {
+        arcs[v].push_back({index.neighbors[e], (int)weights[e], -1});
+      }
+    }
+  });
+
+  // Списки рёбер содержат только оставшиеся вершины: удалённая вершина
+  // сохраняет свой список, это её рёбра вверх, и исчезает из списков соседей
+  std::vector<int> removed_neighbors(n, 0);
+  SearchTree witness;
+  auto priority = [&](int vertex) {
+    return Contract(vertex, false, &arcs, &witness) -
+           (int)arcs[vertex].size() + removed_neighbors[vertex];
+  };
+  // Приоритеты обновляются лениво: вершина с наименьшим приоритетом
+  // пересчитывается и удаляется, только если осталась наименьшей
+  indexed_heap<int> queue(n);
+  for (int v = 0; v < n; v++) queue.push(v, priority(v));
+  ranks_.assign(n);
+  int rank = 0;
+  while (!queue.empty()) {
+    int vertex = queue.top();
+    queue.pop();
+    int current = priority(vertex);
+    if (!queue.empty() && current > queue.top_priority()) {
+      queue.push(vertex, current);
+    } else {
+      Contract(vertex, true, &arcs, &witness);
+      ranks_[vertex] = rank++;
+      for (const Arc &arc : arcs[vertex]) {
+        std::vector<Arc> &list = arcs[arc.target];
+        list.erase(std::find_if(list.begin(), list.end(), [&](const Arc &a) {
+          return a.target == vertex;
+        }));
+        removed_neighbors[arc.target]++;
+      }
+    }
+  }
+  vertices_ = n;
+  BuildUpwardIndex(&arcs);
+  revision_ = graph.GetRevision();
+  fingerprint_ = graph.GetFingerprint();
+}
+
+// Для каждой пары соседей u, x вершины ищет путь из u в x в обход неё не
+// длиннее пути через неё (свидетель). Поиск из u ограничен числом
+// извлечённых вершин и, после рёбер самой u, длиной самого длинного из путей
+// через вершину, для которых свидетель ещё не найден. Свидетель может не
+// найтись, тогда сокращение окажется лишним, но не неверным. Возвращает
+// число нужных сокращений, при apply добавляет их.
+int ContractionHierarchy::Contract(int vertex, bool apply, ArcLists *arcs,
+                                   SearchTree *witness) {
+  const std::vector<Arc> &around = (*arcs)[vertex];
+  const long long infinity = std::numeric_limits<int>::max();
+  int shortcuts = 0;
+  for (size_t i = 0; i + 1 < around.size(); i++) {
+    int source = around[i].target;
+    auto unresolved_limit = [&]() {
+      long long limit = -1;
+      for (size_t j = i + 1; j < around.size(); j++) {
+        long long weight = (long long)around[i].weight + around[j].weight;
+        if (witness->GetDistance(around[j].target) > weight) {
+          limit = std::max(limit, weight);
+        }
+      }
+      return limit;
+    };
+    long long limit = infinity;
+    witness->Begin(arcs->size());
+    indexed_heap<int> &heap = witness->GetHeap();
+    witness->SetLabel(source, 0, -1);
+    heap.push(source, 0);
+    while (!heap.empty() && heap.top_priority() <= limit &&
+           witness->GetSettledCount() < kWitnessSettleLimit) {
+      int current = witness->Settle();
+      long long distance = witness->GetDistance(current);
+      for (const Arc &arc : (*arcs)[current]) {
+        long long candidate = distance + arc.weight;
+        if (arc.target != vertex && candidate <= limit &&
+            candidate < witness->GetDistance(arc.target)) {
+          witness->SetLabel(arc.target, candidate, current);
+          heap.push_or_decrease(arc.target, candidate);
+        }
+      }
+      if (current == source) limit = unresolved_limit();
+    }
+    for (size_t j = i + 1; j < around.size(); j++) {
+      long long weight = (long long)around[i].weight + around[j].weight;
+      if (weight < infinity &&
+          witness->GetDistance(around[j].target) > weight) {
+        shortcuts++;
+        if (apply) AddShortcut(source, around[j].target, weight, vertex, arcs);
+      }
+    }
+  }
+  return shortcuts;
+}
+
+// Параллельное ребро не заводится: более лёгкое сокращение заменяет ребро
+void ContractionHierarchy::AddShortcut(int from, int to, int weight,
+                                       int middle, ArcLists *arcs) {
+  for (int side = 0; side < 2; side++) {
+    std::vector<Arc> &list = (*arcs)[side ? to : from];
+    int target = side ? from : to;
+    auto it = std::find_if(list.begin(), list.end(), [&](const Arc &arc) {
+      return arc.target == target;
+    });
+    if (it == list.end()) {
+      list.push_back({target, weight, middle});
+    } else if (weight < it->weight) {
+      *it = {target, weight, middle};
+    }
+  }
+}
+
+void ContractionHierarchy::BuildUpwardIndex(ArcLists *arcs) {
+  int n = vertices_;
+  ArcLists &upward = *arcs;
+  int max_weight = 0;
+  for (int v = 0; v < n; v++) {
+    for (const Arc &arc : upward[v]) {
+      max_weight = std::max(max_weight, arc.weight);
+      shortcuts_ += (arc.middle != -1);
+    }
+    std::sort(upward[v].begin(), upward[v].end(),
+              [](const Arc &a, const Arc &b) { return a.target < b.target; });
+  }
+  offsets_.assign(n + 1);
+  for (int v = 0; v < n; v++) offsets_[v + 1] = offsets_[v] + upward[v].size();
+  weight_type_ = GetNarrowestWeightType(max_weight);
+  neighbors_.assign(offsets_[n]);
+  middles_.assign(offsets_[n]);
+  weights_.assign((size_t)offsets_[n] * GetWeightSize(weight_type_));
+  VisitWeightType(weight_type_, [&](auto zero) {
+    using W = decltype(zero);
+    W *weights = reinterpret_cast<W *>(weights_.data());
+    for (int v = 0; v < n; v++) {
+      int position = offsets_[v];
+      for (const Arc &arc : upward[v]) {
+        neighbors_[position] = arc.target;
+        middles_[position] = arc.middle;
+        weights[position++] = arc.weight;
+      }
+    }
+  });
+}
+
+int ContractionHierarchy::FindMiddle(int first, int second) const {
+  if (ranks_[first] > ranks_[second]) std::swap(first, second);
+  const int *begin = neighbors_.data() + offsets_[first];
+  const int *end = neighbors_.data() + offsets_[first + 1];
+  const int *found = std::lower_bound(begin, end, second);
+  int middle = -1;
+  if (found != end && *found == second) {
+    middle = middles_[found - neighbors_.data()];
+  }
+  return middle;
+}
+
+std::vector<int> ContractionHierarchy::Unpack(
+    const std::vector<int> &route) const {
+  std::vector<int> result;
+  if (!route.empty()) result.push_back(route.front());
+  // Рёбра разворачиваются стеком: у сокращения (a, b) через m сначала
+  // разворачивается (a, m), затем (m, b)
+  std::vector<std::pair<int, int>> pending;
+  for (size_t i = route.size(); i-- > 1;) {
+    pending.push_back({route[i - 1] - 1, route[i] - 1});
+  }
+  while (!pending.empty()) {
+    auto [first, second] = pending.back();
+    pending.pop_back();
+    int middle = FindMiddle(first, second);
+    if (middle == -1) {
+      result.push_back(second + 1);
+    } else {
+      pending.push_back({middle, second});
+      pending.push_back({first, middle});
+    }
+  }
+  return result;
+}
+
+int ContractionHierarchy::Export(std::string filename) const {
+  int error = 0;
+  if (!std::filesystem::exists(filename)) {
+    std::ofstream out(filename, std::ios::binary);
+    if (!out.is_open()) {
+      error = 1;
+    } else {
+      HierarchyHeader header = {};
+      std::memcpy(header.magic, kHierarchyMagic, sizeof(header.magic));
+      header.version = kHierarchyVersion;
+      header.weight_size = GetWeightSize(weight_type_);
+      header.vertices = vertices_;
+      header.arcs = neighbors_.size();
+      header.fingerprint = fingerprint_;
+      const void *sections[5] = {ranks_.data(), offsets_.data(),
+                                 neighbors_.data(), middles_.data(),
+                                 weights_.data()};
+      size_t bytes[5] = {ranks_.size() * sizeof(int),
+                         offsets_.size() * sizeof(int),
+                         neighbors_.size() * sizeof(int),
+                         middles_.size() * sizeof(int), weights_.size()};
+      header.checksum = kFnvOffset;
+      for (int i = 0; i < 5; i++) {
+        header.checksum = HashBytes(header.checksum, sections[i], bytes[i]);
+      }
+      out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+      for (int i = 0; i < 5; i++) {
+        out.write(static_cast<const char *>(sections[i]), bytes[i]);
+      }
+      if (!out) error = 1;
+      out.close();
+    }
+  } else {
+    error = 4;
+  }
+  return error;
+}
+
+int ContractionHierarchy::Load(const Graph &graph, std::string filename) {
+  int error = 0;
+  std::ifstream in(filename, std::ios::binary);
+  if (!in.is_open() || !std::filesystem::is_regular_file(filename)) {
+    error = 1;
+  }
+  HierarchyHeader header = {};
+  size_t file_size = 0;
+  if (!error) {
+    file_size = std::filesystem::file_size(filename);
+    if (!in.read(reinterpret_cast<char *>(&header), sizeof(header))) error = 2;
+  }
+  if (!error) {
+    uint32_t size = header.weight_size;
+    uint64_t cells = (uint64_t)(2 * header.vertices + 1) + 2 * header.arcs;
+    if (std::memcmp(header.magic, kHierarchyMagic, sizeof(header.magic)) ||
+        header.version != kHierarchyVersion ||
+        (size != 1 && size != 2 && size != 4) ||
+        header.vertices != graph.GetVerticesCount() || header.arcs < 0 ||
+        header.arcs > MAX_GRAPH_SIZE ||
+        header.fingerprint != graph.GetFingerprint() ||
+        file_size !=
+            sizeof(header) + cells * sizeof(int) + header.arcs * size) {
+      error = 2;
+    }
+  }
+  if (!error) {
+    Clear();
+    vertices_ = header.vertices;
+    weight_type_ = GetWeightTypeOfSize(header.weight_size);
+    ranks_.assign(header.vertices);
+    offsets_.assign(header.vertices + 1);
+    neighbors_.assign(header.arcs);
+    middles_.assign(header.arcs);
+    weights_.assign(header.arcs * header.weight_size);
+    void *sections[5] = {ranks_.data(), offsets_.data(), neighbors_.data(),
+                         middles_.data(), weights_.data()};
+    size_t bytes[5] = {ranks_.size() * sizeof(int),
+                       offsets_.size() * sizeof(int),
+                       neighbors_.size() * sizeof(int),
+                       middles_.size() * sizeof(int), weights_.size()};
+    uint64_t checksum = kFnvOffset;
+    for (int i = 0; i < 5; i++) {
+      in.read(static_cast<char *>(sections[i]), bytes[i]);
+      checksum = HashBytes(checksum, sections[i], bytes[i]);
+    }
+    if (!in || checksum != header.checksum) error = 2;
+    if (!error) error = CheckIndex();
+    if (!error) {
+      for (int i = 0; i < (int)middles_.size(); i++) {
+        shortcuts_ += (middles_[i] != -1);
+      }
+      revision_ = graph.GetRevision();
+      fingerprint_ = header.fingerprint;
+    } else {
+      Clear();
+    }
+  }
+  return error;
+}
+
+// Проверяет прочитанную иерархию: ранги образуют перестановку, рёбра ведут
+// к соседям старшего ранга по возрастанию номеров, а вершины сокращений
+// младше концов сокращения, так что разворачивание маршрута конечно
+int ContractionHierarchy::CheckIndex() const {
+  int n = vertices_;
+  int error = 0;
+  std::vector<char> used(n, false);
+  for (int v = 0; v < n && !error; v++) {
+    if (ranks_[v] < 0 || ranks_[v] >= n || used[ranks_[v]]) {
+      error = 2;
+    } else {
+      used[ranks_[v]] = true;
+    }
+  }
+  if (offsets_[0] != 0 || offsets_[n] != (int)neighbors_.size()) error = 2;
+  for (int v = 0; v < n && !error; v++) {
+    if (offsets_[v + 1] < offsets_[v] || offsets_[v + 1] > offsets_[n]) {
+      error = 2;
+    }
+    for (int i = offsets_[v]; i < offsets_[v + 1] && !error; i++) {
+      int target = neighbors_[i], middle = middles_[i];
+      if (target < 0 || target >= n || ranks_[target] <= ranks_[v] ||
+          (i > offsets_[v] && target <= neighbors_[i - 1]) ||
+          (middle != -1 &&
+           (middle < 0 || middle >= n || ranks_[middle] >= ranks_[v]))) {
+        error = 2;
+      }
+    }
+  }
+  return error;
+}
+
+void ContractionHierarchy::Clear() {
+  vertices_ = 0;
+  shortcuts_ = 0;
+  weight_type_ = WeightType::kUint8;
+  revision_ = 0;
+  fingerprint_ = 0;
+  ranks_.clear();
+  offsets_.assign(1);
+  neighbors_.clear();
+  middles_.clear();
+  weights_.clear();
+}
+
+}  // namespace s21
\ No newline at end of file
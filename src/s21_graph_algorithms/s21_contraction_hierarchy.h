@@ -0,0 +1,83 @@
+#ifndef A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_ALGORITHMS_S21_CONTRACTION_HIERARCHY_H
+#define A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_ALGORITHMS_S21_CONTRACTION_HIERARCHY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../s21_containers/s21_aligned_buffer.h"
+#include "../s21_graph/s21_graph.h"
+#include "s21_search_workspace.h"
+
+namespace s21 {
+
+// Иерархия сжатия (contraction hierarchy): вершины по очереди удаляются из
+// графа, а пути через удалённую вершину, не заменимые другими (проверяется
+// поиском свидетеля), сохраняются рёбрами-сокращениями. Ранг вершины —
+// номер её удаления. Кратчайший путь между любыми вершинами тогда есть среди
+// путей, которые сначала поднимаются по рангам, а затем опускаются, поэтому
+// запросу хватает двух поисков вверх по рёбрам к вершинам старшего ранга.
+class ContractionHierarchy {
+ public:
+  // Строит иерархию, удаляя первой вершину с наименьшей разностью числа
+  // добавляемых сокращений и удаляемых рёбер (плюс число уже удалённых
+  // соседей, чтобы удаления расходились по графу равномерно)
+  void Build(const Graph &graph);
+  // Коды ошибок общие для двоичных файлов, см. s21_binary_file.h
+  int Load(const Graph &graph, std::string filename);
+  int Export(std::string filename) const;
+  void Clear();
+
+  // Посчитана ли иерархия для текущего содержимого graph
+  bool IsBuiltFor(const Graph &graph) const {
+    return revision_ == graph.GetRevision();
+  }
+  int GetVerticesCount() const { return vertices_; }
+  int GetShortcutsCount() const { return shortcuts_; }
+  int GetRank(int vertex) const { return ranks_[vertex]; }
+  // Рёбра к соседям старшего ранга (сокращения вместе с рёбрами графа),
+  // соседи каждой вершины идут по возрастанию номеров
+  AdjacencyIndex GetUpwardIndex() const {
+    return {vertices_, offsets_.data(), neighbors_.data(), weights_.data(),
+            weight_type_};
+  }
+
+  // Заменяет сокращения маршрута route (нумерация с 1) путями, которые
+  // они сокращают, получая маршрут по рёбрам графа
+  std::vector<int> Unpack(const std::vector<int> &route) const;
+
+ private:
+  // Ребро графа при сжатии, middle — удалённая вершина сокращения или -1
+  struct Arc {
+    int target;
+    int weight;
+    int middle;
+  };
+  using ArcLists = std::vector<std::vector<Arc>>;
+
+  static int Contract(int vertex, bool apply, ArcLists *arcs,
+                      SearchTree *witness);
+  static void AddShortcut(int from, int to, int weight, int middle,
+                          ArcLists *arcs);
+  // arcs — списки рёбер вершин на момент их удаления
+  void BuildUpwardIndex(ArcLists *arcs);
+  // Удалённая вершина сокращения между соседями first и second или -1
+  int FindMiddle(int first, int second) const;
+  int CheckIndex() const;
+
+  static const int kWitnessSettleLimit = 64;
+  int vertices_ = 0;
+  int shortcuts_ = 0;
+  WeightType weight_type_ = WeightType::kUint8;
+  uint64_t revision_ = 0;
+  uint64_t fingerprint_ = 0;
+  aligned_buffer<int> ranks_;
+  aligned_buffer<int> offsets_;
+  aligned_buffer<int> neighbors_;
+  aligned_buffer<int> middles_;
+  aligned_buffer<unsigned char> weights_;
+};
+
+}  // namespace s21
+
+#endif  // A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_ALGORITHMS_S21_CONTRACTION_HIERARCHY_H
\ No newline at end of file
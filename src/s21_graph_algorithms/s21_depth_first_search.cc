@@ -0,0 +1,64 @@
+#include "s21_graph_algorithms.h"
+
+namespace s21 {
+
+namespace {
+
+// Кадр обхода: вершина (нумерация с 0) и позиция в neighbors следующего ещё
+// не просмотренного ребра. Кадры лежат подряд в векторе, поэтому спуск и
+// возврат не выделяют память, а каждое ребро просматривается один раз.
+struct DepthFirstFrame {
+  int vertex;
+  int next;
+};
+
+DepthFirstTree FindDepthFirstTree(const AdjacencyIndex &index, int source,
+                                  bool with_times) {
+  int n = index.vertices;
+  DepthFirstTree tree;
+  tree.parent.assign(n, 0);
+  if (with_times) {
+    tree.discovery.assign(n, 0);
+    tree.finish.assign(n, 0);
+  }
+  std::vector<bool> visited(n, false);
+  std::vector<DepthFirstFrame> stack;
+  int time = 0;
+  auto discover = [&](int vertex) {
+    visited[vertex] = true;
+    tree.order.push_back(vertex + 1);
+    if (with_times) tree.discovery[vertex] = ++time;
+    stack.push_back({vertex, index.offsets[vertex]});
+  };
+  discover(source);
+  while (!stack.empty()) {
+    DepthFirstFrame &frame = stack.back();
+    int end = index.offsets[frame.vertex + 1];
+    while (frame.next < end && visited[index.neighbors[frame.next]]) {
+      ++frame.next;
+    }
+    if (frame.next < end) {
+      int neighbor = index.neighbors[frame.next++];
+      tree.parent[neighbor] = frame.vertex + 1;
+      discover(neighbor);
+    } else {
+      if (with_times) tree.finish[frame.vertex] = ++time;
+      stack.pop_back();
+    }
+  }
+  return tree;
+}
+
+}  // namespace
+
+DepthFirstTree GraphAlgorithms::DepthFirstSearch(Graph &graph,
+                                                 int start_vertex,
+                                                 bool with_times) {
+  if (start_vertex > graph.GetVerticesCount() || start_vertex < 1) {
+    return DepthFirstTree();
+  }
+  return FindDepthFirstTree(graph.GetAdjacencyIndex(), start_vertex - 1,
+                            with_times);
+}
+
+}  // namespace s21
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "s21_distance_matrix.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace s21 {
+
+namespace {
+
+// Файл матрицы: заголовок, затем rows строк по columns значений int
+const char kMatrixMagic[8] = {'S', '2', '1', 'D', 'M', 'A', 'T', 'X'};
+const uint32_t kMatrixVersion = 1;
+const int64_t kMaxSide = std::numeric_limits<int>::max();
+
+struct MatrixHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t value_size;
+  int64_t rows;
+  int64_t columns;
+};
+
+}  // namespace
+
+void DistanceMatrix::Create(int rows, int columns) {
+  Clear();
+  memory_.assign((size_t)rows * columns);
+  rows_ = rows;
+  columns_ = columns;
+  data_ = memory_.data();
+}
+
+int DistanceMatrix::CreateFile(std::string filename, int rows, int columns) {
+  Clear();
+  size_t bytes = sizeof(MatrixHeader) + (size_t)rows * columns * sizeof(int);
+  int error = file_.Create(filename, bytes);
+  if (!error) {
+    MatrixHeader header = {};
+    std::memcpy(header.magic, kMatrixMagic, sizeof(header.magic));
+    header.version = kMatrixVersion;
+    header.value_size = sizeof(int);
+    header.rows = rows;
+    header.columns = columns;
+    std::memcpy(file_.GetData(), &header, sizeof(header));
+    rows_ = rows;
+    columns_ = columns;
+    data_ = reinterpret_cast<int *>(file_.GetData() + sizeof(header));
+  }
+  return error;
+}
+
+int DistanceMatrix::Open(std::string filename) {
+  Clear();
+  int error = file_.Open(filename);
+  MatrixHeader header = {};
+  if (!error && file_.GetSize() < sizeof(header)) error = 2;
+  if (!error) {
+    std::memcpy(&header, file_.GetData(), sizeof(header));
+    size_t values = (file_.GetSize() - sizeof(header)) / sizeof(int);
+    if (std::memcmp(header.magic, kMatrixMagic, sizeof(header.magic)) ||
+        header.version != kMatrixVersion || header.value_size != sizeof(int) ||
+        header.rows < 0 || header.columns < 0 || header.rows > kMaxSide ||
+        header.columns > kMaxSide ||
+        (file_.GetSize() - sizeof(header)) % sizeof(int) != 0 ||
+        values != (size_t)header.rows * header.columns) {
+      error = 2;
+    }
+  }
+  if (!error) {
+    rows_ = header.rows;
+    columns_ = header.columns;
+    data_ = reinterpret_cast<int *>(file_.GetData() + sizeof(header));
+  } else {
+    file_.Close();
+  }
+  return error;
+}
+
+void DistanceMatrix::Clear() {
+  rows_ = 0;
+  columns_ = 0;
+  data_ = nullptr;
+  memory_.clear();
+  file_.Close();
+}
+
+std::vector<std::vector<int>> DistanceMatrix::ToVectors() const {
+  std::vector<std::vector<int>> result(rows_);
+  for (int i = 0; i < rows_; i++) {
+    result[i].assign(GetRow(i), GetRow(i) + columns_);
+  }
+  return result;
+}
+
+}  // namespace s21
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_ALGORITHMS_S21_DISTANCE_MATRIX_H
+#define A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_ALGORITHMS_S21_DISTANCE_MATRIX_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../s21_containers/s21_aligned_buffer.h"
+#include "../s21_graph/s21_mapped_file.h"
+
+namespace s21 {
+
+// Получатель готовых строк матрицы расстояний: вершина (нумерация с 1) и
+// расстояния от неё до всех вершин графа
+using DistanceRowSink = std::function<void(int vertex, const int *row)>;
+
+// Матрица расстояний, строки которой лежат подряд в одном блоке: в памяти
+// процесса или в отображённом в память файле. Страницы файла система
+// сбрасывает на диск сама, поэтому такая матрица может быть больше
+// оперативной памяти. Матрица не копируется.
+class DistanceMatrix {
+ public:
+  DistanceMatrix() = default;
+  DistanceMatrix(const DistanceMatrix &) = delete;
+  DistanceMatrix &operator=(const DistanceMatrix &) = delete;
+
+  // Матрица в памяти
+  void Create(int rows, int columns);
+  // Матрица в новом файле filename, которую потом читает Open: 1 — файл не
+  // создать, 4 — файл уже существует
+  int CreateFile(std::string filename, int rows, int columns);
+  // Отображает файл матрицы для чтения: 1 — файл не открыть, 2 — файл
+  // повреждён. Изменения строк открытой матрицы в файл не попадают.
+  int Open(std::string filename);
+  void Clear();
+
+  int GetRows() const { return rows_; }
+  int GetColumns() const { return columns_; }
+  // Лежит ли матрица в файле: созданном CreateFile или открытом Open
+  bool IsMapped() const { return file_.GetData() != nullptr; }
+  // Попадают ли изменения строк в файл: только у матрицы из CreateFile
+  bool IsWritable() const { return file_.IsShared(); }
+  int *GetRow(int row) { return data_ + (size_t)row * columns_; }
+  const int *GetRow(int row) const { return data_ + (size_t)row * columns_; }
+  int operator()(int row, int column) const { return GetRow(row)[column]; }
+  std::vector<std::vector<int>> ToVectors() const;
+
+ private:
+  int rows_ = 0;
+  int columns_ = 0;
+  int *data_ = nullptr;
+  aligned_buffer<int> memory_;
+  MappedFile file_;
+};
+
+}  // namespace s21
+
+#endif  // A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_ALGORITHMS_S21_DISTANCE_MATRIX_H
\ No newline at end of file
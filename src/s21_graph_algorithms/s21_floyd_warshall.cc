@@ -0,0 +1,195 @@
+#include "s21_floyd_warshall.h"
+
+#include <algorithm>
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace s21 {
+
+namespace {
+
+const int kBlock = kFloydWarshallBlock;
+
+// Ядра обновляют блок c через блоки a (те же строки) и b (те же столбцы):
+// c[i][j] = min(c[i][j], a[i][k] + b[k][j]) в беззнаковой арифметике, так
+// что сумма больше kNoPath не переполняется и не заменяет c[i][j].
+// RelaxBlock перебирает посредников k во внешнем цикле, поэтому верен и
+// тогда, когда c совпадает с a или b. MultiplyBlock требует, чтобы c не
+// пересекался с a и b, и держит часть строки c в регистрах, пока по ней
+// проходят все k.
+struct BlockKernels {
+  void (*relax)(int *c, const int *a, const int *b, size_t stride);
+  void (*multiply)(int *c, const int *a, const int *b, size_t stride);
+};
+
+void RelaxBlockScalar(int *c, const int *a, const int *b, size_t stride) {
+  for (int k = 0; k < kBlock; k++) {
+    const int *b_row = b + k * stride;
+    for (int i = 0; i < kBlock; i++) {
+      int *c_row = c + i * stride;
+      int a_ik = a[i * stride + k];
+      for (int j = 0; j < kBlock; j++) {
+        c_row[j] = std::min<unsigned>(c_row[j], (unsigned)a_ik + b_row[j]);
+      }
+    }
+  }
+}
+
+// Без векторного ядра строка, до которой нет пути, пропускается, а
+// __restrict позволяет компилятору векторизовать внутренний цикл на
+// процессорах с векторным минимумом целых
+void MultiplyBlockScalar(int *c, const int *a, const int *b, size_t stride) {
+  for (int i = 0; i < kBlock; i++) {
+    int *__restrict c_row = c + i * stride;
+    const int *a_row = a + i * stride;
+    for (int k = 0; k < kBlock; k++) {
+      const int *__restrict b_row = b + k * stride;
+      int a_ik = a_row[k];
+      if (a_ik == kNoPath) continue;
+      for (int j = 0; j < kBlock; j++) {
+        c_row[j] = std::min<unsigned>(c_row[j], (unsigned)a_ik + b_row[j]);
+      }
+    }
+  }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+// Строка блока — 64 int: 8 регистров AVX2 или по половине строки в 8
+// регистрах SSE. Строки блоков выровнены на 64 байта.
+__attribute__((target("avx2"))) void RelaxBlockAvx2(int *c, const int *a,
+                                                    const int *b,
+                                                    size_t stride) {
+  for (int k = 0; k < kBlock; k++) {
+    const int *b_row = b + k * stride;
+    for (int i = 0; i < kBlock; i++) {
+      int *c_row = c + i * stride;
+      __m256i a_ik = _mm256_set1_epi32(a[i * stride + k]);
+      for (int j = 0; j < kBlock; j += 8) {
+        __m256i *c_part = reinterpret_cast<__m256i *>(c_row + j);
+        __m256i b_part =
+            _mm256_load_si256(reinterpret_cast<const __m256i *>(b_row + j));
+        _mm256_store_si256(
+            c_part, _mm256_min_epu32(_mm256_load_si256(c_part),
+                                     _mm256_add_epi32(a_ik, b_part)));
+      }
+    }
+  }
+}
+
+__attribute__((target("avx2"))) void MultiplyBlockAvx2(int *c, const int *a,
+                                                       const int *b,
+                                                       size_t stride) {
+  const int kParts = kBlock / 8;
+  for (int i = 0; i < kBlock; i++) {
+    __m256i *c_row = reinterpret_cast<__m256i *>(c + i * stride);
+    const int *a_row = a + i * stride;
+    __m256i row[kParts];
+    for (int p = 0; p < kParts; p++) row[p] = _mm256_load_si256(c_row + p);
+    for (int k = 0; k < kBlock; k++) {
+      const __m256i *b_row =
+          reinterpret_cast<const __m256i *>(b + k * stride);
+      __m256i a_ik = _mm256_set1_epi32(a_row[k]);
+      for (int p = 0; p < kParts; p++) {
+        row[p] = _mm256_min_epu32(
+            row[p], _mm256_add_epi32(a_ik, _mm256_load_si256(b_row + p)));
+      }
+    }
+    for (int p = 0; p < kParts; p++) _mm256_store_si256(c_row + p, row[p]);
+  }
+}
+
+__attribute__((target("sse4.1"))) void RelaxBlockSse41(int *c, const int *a,
+                                                       const int *b,
+                                                       size_t stride) {
+  for (int k = 0; k < kBlock; k++) {
+    const int *b_row = b + k * stride;
+    for (int i = 0; i < kBlock; i++) {
+      int *c_row = c + i * stride;
+      __m128i a_ik = _mm_set1_epi32(a[i * stride + k]);
+      for (int j = 0; j < kBlock; j += 4) {
+        __m128i *c_part = reinterpret_cast<__m128i *>(c_row + j);
+        __m128i b_part =
+            _mm_load_si128(reinterpret_cast<const __m128i *>(b_row + j));
+        _mm_store_si128(c_part, _mm_min_epu32(_mm_load_si128(c_part),
+                                              _mm_add_epi32(a_ik, b_part)));
+      }
+    }
+  }
+}
+
+__attribute__((target("sse4.1"))) void MultiplyBlockSse41(int *c,
+                                                          const int *a,
+                                                          const int *b,
+                                                          size_t stride) {
+  const int kParts = kBlock / 8;
+  for (int i = 0; i < kBlock; i++) {
+    const int *a_row = a + i * stride;
+    for (int half = 0; half < 2; half++) {
+      __m128i *c_row = reinterpret_cast<__m128i *>(c + i * stride) +
+                       half * kParts;
+      __m128i row[kParts];
+      for (int p = 0; p < kParts; p++) row[p] = _mm_load_si128(c_row + p);
+      for (int k = 0; k < kBlock; k++) {
+        const __m128i *b_row =
+            reinterpret_cast<const __m128i *>(b + k * stride) +
+            half * kParts;
+        __m128i a_ik = _mm_set1_epi32(a_row[k]);
+        for (int p = 0; p < kParts; p++) {
+          row[p] = _mm_min_epu32(
+              row[p], _mm_add_epi32(a_ik, _mm_load_si128(b_row + p)));
+        }
+      }
+      for (int p = 0; p < kParts; p++) _mm_store_si128(c_row + p, row[p]);
+    }
+  }
+}
+
+#endif
+
+BlockKernels SelectBlockKernels() {
+  BlockKernels kernels = {RelaxBlockScalar, MultiplyBlockScalar};
+#if defined(__x86_64__) || defined(__i386__)
+  if (__builtin_cpu_supports("avx2")) {
+    kernels = {RelaxBlockAvx2, MultiplyBlockAvx2};
+  } else if (__builtin_cpu_supports("sse4.1")) {
+    kernels = {RelaxBlockSse41, MultiplyBlockSse41};
+  }
+#endif
+  return kernels;
+}
+
+}  // namespace
+
+void RunFloydWarshall(int *distance, int size, ThreadPool *pool) {
+  static const BlockKernels kernels = SelectBlockKernels();
+  const size_t stride = size;
+  const int blocks = size / kBlock;
+  auto block = [&](int row, int column) {
+    return distance + (size_t)row * kBlock * stride + (size_t)column * kBlock;
+  };
+  for (int k = 0; k < blocks; k++) {
+    int *diagonal = block(k, k);
+    kernels.relax(diagonal, diagonal, diagonal, stride);
+    // Задачи 2j и 2j + 1 — блок j строки k и блок j столбца k
+    pool->ParallelFor(2 * blocks, [&](int task, int) {
+      int j = task / 2;
+      if (j != k && task % 2 == 0) {
+        kernels.relax(block(k, j), diagonal, block(k, j), stride);
+      } else if (j != k) {
+        kernels.relax(block(j, k), block(j, k), diagonal, stride);
+      }
+    });
+    pool->ParallelFor(blocks * blocks, [&](int task, int) {
+      int i = task / blocks, j = task % blocks;
+      if (i != k && j != k) {
+        kernels.multiply(block(i, j), block(i, k), block(k, j), stride);
+      }
+    });
+  }
+}
+
+}  // namespace s21
\ No newline at end of file
@@ -0,0 +1,34 @@
+#ifndef A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_ALGORITHMS_S21_FLOYD_WARSHALL_H
+#define A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_ALGORITHMS_S21_FLOYD_WARSHALL_H
+
+#include <limits>
+
+#include "../s21_graph/s21_thread_pool.h"
+
+namespace s21 {
+
+// Расстояние «пути нет» в матрице Флойда-Уоршелла. Элементы матрицы не
+// больше kNoPath, поэтому сумма двух из них помещается в unsigned: ядро
+// складывает и берёт минимум без знака, без проверок переполнения. Пути
+// короче kNoPath получаются точными, как у Дейкстры, а более длинные
+// становятся kNoPath.
+const int kNoPath = std::numeric_limits<int>::max();
+
+// Сторона квадратного блока матрицы
+const int kFloydWarshallBlock = 64;
+
+// Считает кратчайшие пути на месте в матрице size x size, лежащей по строкам
+// подряд, с выравниванием начала на 64 байта. size кратен
+// kFloydWarshallBlock, элементы не больше kNoPath. Матрица обходится
+// блоками, которые помещаются в кэш: на шаге по блоку k сначала
+// пересчитывается диагональный блок, затем блоки его строки и столбца, а
+// остальные блоки обновляются min-plus произведением блоков строки и
+// столбца векторным ядром (AVX2 или SSE4.1 по возможностям процессора).
+// Блоки строки и столбца и затем остальные блоки независимы друг от друга и
+// делятся между потоками pool; каждый блок считается одним потоком в том же
+// порядке, поэтому результат не зависит от числа потоков.
+void RunFloydWarshall(int *distance, int size, ThreadPool *pool);
+
+}  // namespace s21
+
+#endif  // A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_ALGORITHMS_S21_FLOYD_WARSHALL_H
\ No newline at end of file
@@ -1,42 +1,153 @@
 #include "s21_graph_algorithms.h"
 
+#include <algorithm>
+#include <limits>
+
+#include "../s21_containers/s21_disjoint_set.h"
+#include "../s21_containers/s21_indexed_heap.h"
+
 namespace s21 {
 
-std::vector<std::vector<int>> GraphAlgorithms::GetLeastSpanningTree(
-    Graph &graph) {
-  std::vector<std::vector<int>> result(
-      graph.GetVerticesCount(), std::vector<int>(graph.GetVerticesCount(), 0));
-  int count = graph.GetVerticesCount();
-  std::vector<bool> selected(count, false);
-  int unselected = graph.GetVerticesCount();
-  selected[0] = true;
-  while (unselected > 0) {
-    int min = MAX_GRAPH_SIZE;
-    int x = 0;
-    int y = 0;
-    for (int i = 0; i < count; i++) {
-      if (selected[i] == true) {  //  проходим по всем выбранным ранее вершинам
-        for (int j = 0; j < count; j++) {
-          if (!selected[j] && graph.GetVergeWeight(i + 1, j + 1)) {
-            if (min > graph.GetVergeWeight(i + 1, j + 1)) {
-              min = graph.GetVergeWeight(i + 1, j + 1);
-              x = i;
-              y = j;
-            }
-          }
+namespace {
+
+// Ребро с нумерацией вершин с 0, from < to. Рёбра упорядочены по весу, при
+// равном весе — по концам, поэтому порядок не зависит от сортировки.
+struct WeightedEdge {
+  int weight;
+  int from;
+  int to;
+
+  bool operator<(const WeightedEdge &other) const {
+    return weight != other.weight ? weight < other.weight
+           : from != other.from   ? from < other.from
+                                  : to < other.to;
+  }
+};
+
+// Куча хранит не вошедшие в дерево вершины с весом самого лёгкого ребра от
+// дерева до них: каждое ребро просматривается один раз, O(m log n)
+template <typename W>
+SpanningTree FindSpanningTreePrim(const AdjacencyIndex &index) {
+  SpanningTree result = {{}, 0, 0};
+  const W *weights = index.GetWeights<W>();
+  int count = index.vertices;
+  std::vector<char> selected(count, false);
+  std::vector<int> lightest(count, std::numeric_limits<int>::max());
+  std::vector<int> parent(count, -1);
+  indexed_heap<int> heap(count);
+  for (int root = 0; root < count; root++) {
+    if (selected[root]) continue;
+    result.components++;
+    lightest[root] = 0;
+    heap.push(root, 0);
+    while (!heap.empty()) {
+      int vertex = heap.top();
+      heap.pop();
+      selected[vertex] = true;
+      if (parent[vertex] != -1) {
+        result.edges.push_back(
+            {parent[vertex] + 1, vertex + 1, lightest[vertex]});
+        result.weight += lightest[vertex];
+      }
+      for (int e = index.offsets[vertex]; e < index.offsets[vertex + 1];
+           e++) {
+        int neighbor = index.neighbors[e];
+        if (!selected[neighbor] && weights[e] < lightest[neighbor]) {
+          lightest[neighbor] = weights[e];
+          parent[neighbor] = vertex;
+          heap.push_or_decrease(neighbor, weights[e]);
         }
       }
     }
-    selected[y] = true;
-    unselected--;
-    if (x == 0 && y == 0) {
-      result[x][y] = 0;
-    } else {
-      result[y][x] = min;
-      result[x][y] = min;
+  }
+  return result;
+}
+
+// Части edges сортируются на потоках pool, затем соседние части сливаются
+// попарно, тоже параллельно, пока не останется одна
+void SortEdges(std::vector<WeightedEdge> *edges, ThreadPool *pool) {
+  int parts = pool->GetThreadsCount();
+  size_t size = edges->size();
+  std::vector<size_t> bounds(parts + 1);
+  for (int p = 0; p <= parts; p++) bounds[p] = size * p / parts;
+  pool->ParallelFor(parts, [&](int p, int) {
+    std::sort(edges->begin() + bounds[p], edges->begin() + bounds[p + 1]);
+  });
+  std::vector<WeightedEdge> merged(parts > 1 ? size : 0);
+  for (int width = 1; width < parts; width *= 2) {
+    pool->ParallelFor((parts + 2 * width - 1) / (2 * width), [&](int m, int) {
+      int first = 2 * m * width;
+      int middle = std::min(first + width, parts);
+      int last = std::min(first + 2 * width, parts);
+      auto begin = edges->begin();
+      std::merge(begin + bounds[first], begin + bounds[middle],
+                 begin + bounds[middle], begin + bounds[last],
+                 merged.begin() + bounds[first]);
+    });
+    edges->swap(merged);
+  }
+}
+
+// Рёбра по возрастанию веса добавляются в остов, если соединяют разные
+// деревья леса. Каждое ребро неориентированного графа берётся один раз, со
+// стороны младшей вершины.
+template <typename W>
+SpanningTree FindSpanningTreeKruskal(const AdjacencyIndex &index,
+                                     ThreadPool *pool) {
+  SpanningTree result = {{}, 0, 0};
+  const W *weights = index.GetWeights<W>();
+  std::vector<WeightedEdge> edges;
+  edges.reserve(index.offsets[index.vertices] / 2);
+  for (int v = 0; v < index.vertices; v++) {
+    for (int e = index.offsets[v]; e < index.offsets[v + 1]; e++) {
+      if (index.neighbors[e] > v) {
+        edges.push_back({(int)weights[e], v, index.neighbors[e]});
+      }
+    }
+  }
+  SortEdges(&edges, pool);
+  disjoint_set forest(index.vertices);
+  for (size_t i = 0; i < edges.size() && forest.count() > 1; i++) {
+    const WeightedEdge &edge = edges[i];
+    if (forest.merge(edge.from, edge.to)) {
+      result.edges.push_back({edge.from + 1, edge.to + 1, edge.weight});
+      result.weight += edge.weight;
     }
   }
+  result.components = forest.count();
+  return result;
+}
+
+}  // namespace
+
+std::vector<std::vector<int>> GraphAlgorithms::GetLeastSpanningTree(
+    Graph &graph, SpanningTreeMode mode) {
+  std::vector<std::vector<int>> result(
+      graph.GetVerticesCount(), std::vector<int>(graph.GetVerticesCount(), 0));
+  for (const SpanningEdge &edge :
+       GetLeastSpanningTreeEdges(graph, mode).edges) {
+    result[edge.from - 1][edge.to - 1] = edge.weight;
+    result[edge.to - 1][edge.from - 1] = edge.weight;
+  }
   return result;
 }
 
+SpanningTree GraphAlgorithms::GetLeastSpanningTreeEdges(Graph &graph,
+                                                        SpanningTreeMode mode,
+                                                        int threads) {
+  AdjacencyIndex index = graph.GetAdjacencyIndex();
+  // Веса читаются в типе хранения графа, сравниваются как int
+  return VisitWeightType(index.weight_type, [&](auto zero) {
+    using W = decltype(zero);
+    SpanningTree result;
+    if (mode == SpanningTreeMode::kKruskal) {
+      ThreadPool pool(threads);
+      result = FindSpanningTreeKruskal<W>(index, &pool);
+    } else {
+      result = FindSpanningTreePrim<W>(index);
+    }
+    return result;
+  });
+}
+
 }  // namespace s21
\ No newline at end of file
@@ -1,13 +1,265 @@
 #include "s21_graph_algorithms.h"
 
 #include <cmath>
+#include <functional>
 #include <limits>
 
+#include "../s21_containers/s21_indexed_heap.h"
 #include "../s21_containers/s21_queue.h"
 #include "../s21_containers/s21_stack.h"
+#include "s21_floyd_warshall.h"
 
 namespace s21 {
 
+namespace {
+
+// Длина кратчайшего пути от source до target (нумерация с 0) или
+// numeric_limits<int>::max(), если target недостижима; родители вершин
+// остаются в workspace для восстановления маршрута. Суммы весов считаются в
+// long long, поэтому длина больше int считается недостижимой.
+template <typename W>
+int FindShortestDistanceUnidirectional(const AdjacencyIndex& index, int source,
+                                       int target, SearchWorkspace& workspace) {
+  const W* weights = index.GetWeights<W>();
+  workspace.Begin(index.vertices, SearchMode::kUnidirectional);
+  SearchTree& tree = workspace.GetForward();
+  indexed_heap<int>& heap = tree.GetHeap();
+  tree.SetLabel(source, 0, -1);
+  heap.push(source, 0);
+  while (!heap.empty() && heap.top() != target) {
+    int vertex = tree.Settle();
+    long long distance = tree.GetDistance(vertex);
+    for (int e = index.offsets[vertex]; e < index.offsets[vertex + 1]; ++e) {
+      int neighbor = index.neighbors[e];
+      long long candidate = distance + weights[e];
+      if (candidate < tree.GetDistance(neighbor)) {
+        tree.SetLabel(neighbor, candidate, vertex);
+        heap.push_or_decrease(neighbor, candidate);
+      }
+    }
+  }
+  return tree.GetDistance(target);
+}
+
+// Извлекает ближайшую вершину дерева tree и улучшает метки её соседей.
+// Вершина, достигнутая обоими деревьями, даёт путь длины суммы их меток:
+// лучший из таких путей хранится в *best и точке встречи workspace.
+template <typename W>
+void ExpandSearchTree(const AdjacencyIndex& index, SearchTree& tree,
+                      const SearchTree& other, long long* best,
+                      SearchWorkspace& workspace) {
+  const W* weights = index.GetWeights<W>();
+  int vertex = tree.Settle();
+  long long distance = tree.GetDistance(vertex);
+  for (int e = index.offsets[vertex]; e < index.offsets[vertex + 1]; ++e) {
+    int neighbor = index.neighbors[e];
+    long long candidate = distance + weights[e];
+    if (candidate < tree.GetDistance(neighbor)) {
+      tree.SetLabel(neighbor, candidate, vertex);
+      tree.GetHeap().push_or_decrease(neighbor, candidate);
+      if (other.IsReached(neighbor) &&
+          candidate + other.GetDistance(neighbor) < *best) {
+        *best = candidate + other.GetDistance(neighbor);
+        workspace.SetMeeting(neighbor);
+      }
+    }
+  }
+}
+
+// Двунаправленная Дейкстра: деревья растут от source и от target, каждый
+// шаг расширяется дерево с меньшим радиусом. Поиск останавливается, когда
+// сумма радиусов не меньше лучшего найденного пути: более короткий путь
+// прошёл бы через вершину, ещё не извлечённую ни одним деревом.
+template <typename W>
+int FindShortestDistanceBidirectional(const AdjacencyIndex& index, int source,
+                                      int target, SearchWorkspace& workspace) {
+  workspace.Begin(index.vertices, SearchMode::kBidirectional);
+  SearchTree& forward = workspace.GetForward();
+  SearchTree& backward = workspace.GetBackward();
+  forward.SetLabel(source, 0, -1);
+  forward.GetHeap().push(source, 0);
+  backward.SetLabel(target, 0, -1);
+  backward.GetHeap().push(target, 0);
+  long long best = std::numeric_limits<int>::max();
+  while (!forward.GetHeap().empty() && !backward.GetHeap().empty()) {
+    int forward_radius = forward.GetHeap().top_priority();
+    int backward_radius = backward.GetHeap().top_priority();
+    if ((long long)forward_radius + backward_radius >= best) break;
+    if (forward_radius <= backward_radius) {
+      ExpandSearchTree<W>(index, forward, backward, &best, workspace);
+    } else {
+      ExpandSearchTree<W>(index, backward, forward, &best, workspace);
+    }
+  }
+  return best;
+}
+
+// Запрос к иерархии сжатия: деревья растут от source и от target только
+// по рёбрам вверх по рангам. Каждое дерево расширяется, пока его радиус
+// меньше лучшего пути через точку встречи: в отличие от обычной
+// двунаправленной Дейкстры, вершина кратчайшего пути со старшим рангом может
+// быть извлечена одним деревом заметно позже другого.
+template <typename W>
+int FindShortestDistanceHierarchy(const AdjacencyIndex& upward, int source,
+                                  int target, SearchWorkspace& workspace) {
+  workspace.Begin(upward.vertices, SearchMode::kContractionHierarchy);
+  SearchTree& forward = workspace.GetForward();
+  SearchTree& backward = workspace.GetBackward();
+  forward.SetLabel(source, 0, -1);
+  forward.GetHeap().push(source, 0);
+  backward.SetLabel(target, 0, -1);
+  backward.GetHeap().push(target, 0);
+  long long best = std::numeric_limits<int>::max();
+  auto is_open = [&](SearchTree& tree) {
+    return !tree.GetHeap().empty() && tree.GetHeap().top_priority() < best;
+  };
+  while (is_open(forward) || is_open(backward)) {
+    if (is_open(forward) &&
+        (!is_open(backward) || forward.GetHeap().top_priority() <=
+                                   backward.GetHeap().top_priority())) {
+      ExpandSearchTree<W>(upward, forward, backward, &best, workspace);
+    } else {
+      ExpandSearchTree<W>(upward, backward, forward, &best, workspace);
+    }
+  }
+  return best;
+}
+
+// A* от source с оценкой остатка пути по таблице опорных вершин. Оценка
+// согласована, поэтому, как и в Дейкстре, каждая вершина извлекается один
+// раз и поиск заканчивается извлечением target. Вершины, путь через которые
+// не короче numeric_limits<int>::max(), в кучу не попадают.
+template <typename W, typename D>
+int FindShortestDistanceLandmarks(const AdjacencyIndex& index,
+                                  const LandmarkTable& landmarks, int source,
+                                  int target, SearchWorkspace& workspace) {
+  const int infinity = std::numeric_limits<int>::max();
+  const int unreachable = std::numeric_limits<D>::max();
+  const int count = landmarks.GetCount();
+  const W* weights = index.GetWeights<W>();
+  const D* target_row = landmarks.GetDistances<D>(target);
+  auto lower_bound = [&](int vertex) {
+    return LandmarkTable::GetLowerBound(landmarks.GetDistances<D>(vertex),
+                                        target_row, count, unreachable);
+  };
+  workspace.Begin(index.vertices, SearchMode::kLandmarks);
+  SearchTree& tree = workspace.GetForward();
+  indexed_heap<int>& heap = tree.GetHeap();
+  if (!landmarks.AreSeparated(source, target)) {
+    tree.SetLabel(source, 0, -1);
+    heap.push(source, lower_bound(source));
+  }
+  while (!heap.empty() && heap.top() != target) {
+    int vertex = tree.Settle();
+    long long distance = tree.GetDistance(vertex);
+    for (int e = index.offsets[vertex]; e < index.offsets[vertex + 1]; ++e) {
+      int neighbor = index.neighbors[e];
+      long long candidate = distance + weights[e];
+      if (candidate < tree.GetDistance(neighbor)) {
+        long long priority = candidate + lower_bound(neighbor);
+        if (priority < infinity) {
+          tree.SetLabel(neighbor, candidate, vertex);
+          heap.push_or_decrease(neighbor, priority);
+        }
+      }
+    }
+  }
+  return tree.GetDistance(target);
+}
+
+// Дейкстра от source, которая останавливается, когда извлечены все
+// targets_count различных вершин, отмеченных в is_target: расстояния до
+// них остаются в tree
+template <typename W>
+void FindDistancesToTargets(const AdjacencyIndex& index, int source,
+                            const std::vector<char>& is_target,
+                            int targets_count, SearchTree& tree) {
+  const W* weights = index.GetWeights<W>();
+  indexed_heap<int>& heap = tree.GetHeap();
+  tree.Begin(index.vertices);
+  tree.SetLabel(source, 0, -1);
+  heap.push(source, 0);
+  int remaining = targets_count;
+  while (!heap.empty() && remaining > 0) {
+    int vertex = tree.Settle();
+    if (is_target[vertex]) remaining--;
+    long long distance = tree.GetDistance(vertex);
+    for (int e = index.offsets[vertex]; e < index.offsets[vertex + 1]; ++e) {
+      int neighbor = index.neighbors[e];
+      long long candidate = distance + weights[e];
+      if (candidate < tree.GetDistance(neighbor)) {
+        tree.SetLabel(neighbor, candidate, vertex);
+        heap.push_or_decrease(neighbor, candidate);
+      }
+    }
+  }
+}
+
+// Один поиск от источника обслуживает все цели сразу и заканчивается, как
+// только извлечена самая дальняя из них. Расстояния от sources[i] (i <
+// count) до targets пишутся в row(i), numeric_limits<int>::max() для
+// недостижимых и несуществующих вершин. У каждого потока pool своё дерево
+// поиска, которое переиспользуется между его источниками.
+void FindDistanceRows(const AdjacencyIndex& index, const int* sources,
+                      int count, const std::vector<int>& targets,
+                      ThreadPool* pool,
+                      const std::function<int*(int)>& row) {
+  const int infinity = std::numeric_limits<int>::max();
+  int vertices_count = index.vertices;
+  auto exist = [&](int vertex) {
+    return vertex >= 1 && vertex <= vertices_count;
+  };
+  std::vector<char> is_target(vertices_count, 0);
+  int targets_count = 0;
+  for (int target : targets) {
+    if (exist(target) && !is_target[target - 1]) {
+      is_target[target - 1] = 1;
+      targets_count++;
+    }
+  }
+
+  std::vector<SearchTree> trees(pool->GetThreadsCount());
+  pool->ParallelFor(count, [&](int i, int thread) {
+    int source = sources[i];
+    int* distances = row(i);
+    std::fill(distances, distances + targets.size(), infinity);
+    if (exist(source) && targets_count > 0) {
+      SearchTree& tree = trees[thread];
+      VisitWeightType(index.weight_type, [&](auto zero) {
+        FindDistancesToTargets<decltype(zero)>(index, source - 1, is_target,
+                                               targets_count, tree);
+      });
+      for (size_t j = 0; j < targets.size(); j++) {
+        if (exist(targets[j])) distances[j] = tree.GetDistance(targets[j] - 1);
+      }
+    }
+  });
+}
+
+// Флойд-Уоршелл стоит size^3 обновлений ячейки матрицы (size — число
+// вершин, дополненное до блока), Дейкстра от каждой вершины — примерно
+// kDijkstraArcCost таких обновлений на ребро и kDijkstraVertexCost на
+// вершину из-за кучи и произвольного доступа к памяти. Для разреженных
+// графов поэтому выбирается Дейкстра.
+bool IsDijkstraCheaper(const AdjacencyIndex& index) {
+  const long long kDijkstraArcCost = 12;
+  const long long kDijkstraVertexCost = 500;
+  long long n = index.vertices;
+  long long arcs = index.offsets[n];
+  long long size = (n + kFloydWarshallBlock - 1) / kFloydWarshallBlock *
+                   kFloydWarshallBlock;
+  return kDijkstraArcCost * arcs + kDijkstraVertexCost * n < size * size;
+}
+
+// Число потоков для tasks независимых задач: threads или, если threads не
+// больше 0, по числу ядер, но не больше числа задач
+int CountThreads(int threads, long long tasks) {
+  long long count = threads > 0 ? threads : ThreadPool::GetHardwareThreads();
+  return std::max(1LL, std::min(count, tasks));
+}
+
+}  // namespace
+
 std::vector<int> GraphAlgorithms::DepthFirstSearch(Graph& graph,
                                                    int start_vertex) {
   std::vector<int> result;
@@ -15,7 +267,7 @@ std::vector<int> GraphAlgorithms::DepthFirstSearch(Graph& graph,
   if (start_vertex > vertices_count || start_vertex < 1) {
     return result;
   }
-  std::vector<bool> visited(vertices_count, false);
+  std::vector<bool> visited(vertices_count + 1, false);
   s21::stack<int> stack;
   visited[start_vertex] = true;
   stack.push(start_vertex);
@@ -23,8 +275,10 @@ std::vector<int> GraphAlgorithms::DepthFirstSearch(Graph& graph,
     int vertex = stack.top();
     stack.pop();
     result.push_back(vertex);
-    std::vector<int> adjacents = graph.GetAdjacentVertices(vertex);
-    for (int v : adjacents) {
+    // Соседи обходятся от старших к младшим, как в GetAdjacentVertices
+    NeighborRange neighbors = graph.GetNeighbors(vertex);
+    for (auto it = neighbors.rbegin(); it != neighbors.rend(); ++it) {
+      int v = (*it).vertex;
       if (!visited[v]) {
         visited[v] = true;
         stack.push(v);
@@ -41,7 +295,7 @@ std::vector<int> GraphAlgorithms::BreadthFirstSearch(Graph& graph,
   if (start_vertex > vertices_count || start_vertex < 1) {
     return result;
   }
-  std::vector<bool> visited(vertices_count, false);
+  std::vector<bool> visited(vertices_count + 1, false);
   s21::queue<int> queue;
   visited[start_vertex] = true;
   queue.push(start_vertex);
@@ -49,8 +303,10 @@ std::vector<int> GraphAlgorithms::BreadthFirstSearch(Graph& graph,
     int vertex = queue.front();
     queue.pop();
     result.push_back(vertex);
-    std::vector<int> adjacents = graph.GetAdjacentVertices(vertex);
-    for (int v : adjacents) {
+    // Соседи обходятся от старших к младшим, как в GetAdjacentVertices
+    NeighborRange neighbors = graph.GetNeighbors(vertex);
+    for (auto it = neighbors.rbegin(); it != neighbors.rend(); ++it) {
+      int v = (*it).vertex;
       if (!visited[v]) {
         visited[v] = true;
         queue.push(v);
@@ -60,75 +316,213 @@ std::vector<int> GraphAlgorithms::BreadthFirstSearch(Graph& graph,
   return result;
 }
 
+// Дейкстра по d-арной куче с уменьшением ключа: каждая вершина извлекается
+// из кучи один раз, поиск останавливается, как только извлечена vertex2
 int GraphAlgorithms::GetShortestPathBetweenVertices(Graph& graph, int vertex1,
                                                     int vertex2) {
+  SearchWorkspace workspace;
+  return GetShortestPathBetweenVertices(graph, vertex1, vertex2, workspace);
+}
+
+int GraphAlgorithms::GetShortestPathBetweenVertices(Graph& graph, int vertex1,
+                                                    int vertex2,
+                                                    SearchWorkspace& workspace,
+                                                    SearchMode mode) {
   int result = 0;
   if (vertex1 == vertex2) {
     result = graph.GetVergeWeight(vertex1, vertex2);
   } else {
-    int verticesCount = graph.GetVerticesCount();
-    std::vector<int> distances(verticesCount + 1,
-                               std::numeric_limits<int>::max());
-    distances[vertex1] = 0;
-    s21::queue<int> queue;
-    queue.push(vertex1);
-    std::set<int> visited;
-    while (!queue.empty()) {
-      int currentVertex = queue.front();
-      queue.pop();
-      if (visited.find(currentVertex) != visited.end()) {
-        continue;  // Пропускаем уже посещенные вершины
-      }
-      visited.insert(currentVertex);
-      for (int neighbor : graph.GetAdjacentVertices(currentVertex)) {
-        int weight = graph.GetVergeWeight(currentVertex, neighbor);
-        int newDistance = distances[currentVertex] + weight;
-        if (newDistance < distances[neighbor]) {
-          distances[neighbor] = newDistance;
-          queue.push(neighbor);  // Добавляем соседа в очередь
-        }
-      }
+    result = FindShortestDistance(graph, vertex1, vertex2, workspace, mode);
+  }
+  return result;
+}
+
+// Маршрут из вершины в себя, как и длина в GetShortestPathBetweenVertices,
+// проходит по петле, если она есть. Для недостижимой или несуществующей
+// вершины маршрут пуст, а длина равна numeric_limits<int>::max().
+RouteResult GraphAlgorithms::GetShortestRouteBetweenVertices(
+    Graph& graph, int vertex1, int vertex2, SearchWorkspace& workspace,
+    SearchMode mode) {
+  RouteResult result = {{}, std::numeric_limits<int>::max()};
+  int vertices_count = graph.GetVerticesCount();
+  bool exist = vertex1 >= 1 && vertex1 <= vertices_count && vertex2 >= 1 &&
+               vertex2 <= vertices_count;
+  if (exist && vertex1 == vertex2) {
+    result.distance = graph.GetVergeWeight(vertex1, vertex2);
+    result.vertices.assign(result.distance ? 2 : 1, vertex1);
+  } else if (exist) {
+    result.distance =
+        FindShortestDistance(graph, vertex1, vertex2, workspace, mode);
+    result.vertices = workspace.GetRoute(vertex2 - 1);
+    if (mode == SearchMode::kContractionHierarchy) {
+      result.vertices = hierarchy_.Unpack(result.vertices);
     }
-    result = distances[vertex2];
   }
   return result;
 }
 
+const LandmarkTable& GraphAlgorithms::GetLandmarkTable(Graph& graph) {
+  if (!landmarks_.IsBuiltFor(graph)) landmarks_.Build(graph);
+  return landmarks_;
+}
+
+int GraphAlgorithms::LoadLandmarkTable(Graph& graph, std::string filename) {
+  return landmarks_.Load(graph, filename);
+}
+
+int GraphAlgorithms::ExportLandmarkTable(Graph& graph, std::string filename) {
+  return GetLandmarkTable(graph).Export(filename);
+}
+
+const ContractionHierarchy& GraphAlgorithms::GetContractionHierarchy(
+    Graph& graph) {
+  if (!hierarchy_.IsBuiltFor(graph)) hierarchy_.Build(graph);
+  return hierarchy_;
+}
+
+int GraphAlgorithms::LoadContractionHierarchy(Graph& graph,
+                                              std::string filename) {
+  return hierarchy_.Load(graph, filename);
+}
+
+int GraphAlgorithms::ExportContractionHierarchy(Graph& graph,
+                                                std::string filename) {
+  return GetContractionHierarchy(graph).Export(filename);
+}
+
+int GraphAlgorithms::FindShortestDistance(Graph& graph, int vertex1,
+                                          int vertex2,
+                                          SearchWorkspace& workspace,
+                                          SearchMode mode) {
+  AdjacencyIndex index = graph.GetAdjacencyIndex();
+  const LandmarkTable* landmarks = nullptr;
+  if (mode == SearchMode::kLandmarks) landmarks = &GetLandmarkTable(graph);
+  if (mode == SearchMode::kContractionHierarchy) {
+    index = GetContractionHierarchy(graph).GetUpwardIndex();
+  }
+  return VisitWeightType(index.weight_type, [&](auto zero) {
+    using W = decltype(zero);
+    int result = 0;
+    if (mode == SearchMode::kContractionHierarchy) {
+      result = FindShortestDistanceHierarchy<W>(index, vertex1 - 1,
+                                                vertex2 - 1, workspace);
+    } else if (mode == SearchMode::kLandmarks) {
+      result = VisitWeightType(landmarks->GetDistanceType(), [&](auto type) {
+        return FindShortestDistanceLandmarks<W, decltype(type)>(
+            index, *landmarks, vertex1 - 1, vertex2 - 1, workspace);
+      });
+    } else if (mode == SearchMode::kBidirectional) {
+      result = FindShortestDistanceBidirectional<W>(index, vertex1 - 1,
+                                                    vertex2 - 1, workspace);
+    } else {
+      result = FindShortestDistanceUnidirectional<W>(index, vertex1 - 1,
+                                                     vertex2 - 1, workspace);
+    }
+    return result;
+  });
+}
+
 std::vector<std::vector<int>>
-GraphAlgorithms::GetShortestPathsBetweenAllVertices(Graph& graph) {
-  int verticesCount = graph.GetVerticesCount();
-  std::vector<std::vector<int>> distance(
-      verticesCount,
-      std::vector<int>(verticesCount, std::numeric_limits<int>::max()));
+GraphAlgorithms::GetShortestPathsBetweenAllVertices(Graph& graph,
+                                                    int threads) {
+  DistanceMatrix result;
+  GetShortestPathsBetweenAllVertices(graph, result, threads);
+  return result.ToVectors();
+}
 
-  // Инициализация матрицы расстояний
-  for (int i = 0; i < verticesCount; ++i) {
-    distance[i][i] = 0;  // Расстояние до самого себя равно 0
-    for (int j = 0; j < verticesCount; ++j) {
-      if (i != j) {
-        int weight =
-            graph.GetVergeWeight(i + 1, j + 1);  // Индексация вершин с 1
-        if (weight > 0) {  // Проверка существования ребра
-          distance[i][j] = weight;
-        }
-      }
+// Флойду-Уоршеллу нужна вся матрица в памяти, поэтому для матрицы в файле
+// всегда считается Дейкстра от каждой вершины. Строки открытой матрицы
+// легли бы в копируемые при записи страницы, которые не попадают в файл и
+// занимают память процесса, поэтому она пересоздаётся в памяти.
+void GraphAlgorithms::GetShortestPathsBetweenAllVertices(Graph& graph,
+                                                         DistanceMatrix& result,
+                                                         int threads) {
+  int n = graph.GetVerticesCount();
+  if (result.GetRows() != n || result.GetColumns() != n ||
+      (result.IsMapped() && !result.IsWritable())) {
+    result.Create(n, n);
+  }
+  if (result.IsWritable() || IsDijkstraCheaper(graph.GetAdjacencyIndex())) {
+    std::vector<int> vertices(n);
+    for (int v = 0; v < n; v++) vertices[v] = v + 1;
+    ThreadPool pool(CountThreads(threads, n));
+    FindDistanceRows(graph.GetAdjacencyIndex(), vertices.data(), n, vertices,
+                     &pool, [&](int i) { return result.GetRow(i); });
+  } else {
+    GetShortestPathsFloydWarshall(graph, result, threads);
+  }
+}
+
+// Строки считаются порциями по kStreamRowsPerThread на поток: память —
+// только на порцию строк, а sink получает строки по порядку вершин
+void GraphAlgorithms::StreamShortestPathsBetweenAllVertices(
+    Graph& graph, const DistanceRowSink& sink, int threads) {
+  const int kStreamRowsPerThread = 4;
+  const int kStreamMinRows = 64;
+  int n = graph.GetVerticesCount();
+  std::vector<int> vertices(n);
+  for (int v = 0; v < n; v++) vertices[v] = v + 1;
+  ThreadPool pool(CountThreads(threads, n));
+  int chunk = std::max(kStreamMinRows,
+                       kStreamRowsPerThread * pool.GetThreadsCount());
+  std::vector<int> rows((size_t)std::min(chunk, n) * n);
+  for (int first = 0; first < n; first += chunk) {
+    int count = std::min(chunk, n - first);
+    FindDistanceRows(graph.GetAdjacencyIndex(), vertices.data() + first,
+                     count, vertices, &pool,
+                     [&](int i) { return rows.data() + (size_t)i * n; });
+    for (int i = 0; i < count; i++) {
+      sink(first + i + 1, rows.data() + (size_t)i * n);
     }
   }
+}
+
+// Матрица дополняется до размера, кратного блоку Флойда-Уоршелла,
+// изолированными вершинами. kNoPath равно numeric_limits<int>::max(), поэтому
+// строки копируются в результат как есть.
+void GraphAlgorithms::GetShortestPathsFloydWarshall(Graph& graph,
+                                                    DistanceMatrix& result,
+                                                    int threads) {
+  int verticesCount = graph.GetVerticesCount();
+  const size_t block = kFloydWarshallBlock;
+  size_t size = (verticesCount + block - 1) / block * block;
+  aligned_buffer<int> distance(size * size);
+  std::fill(distance.data(), distance.data() + size * size, kNoPath);
 
-  // Алгоритм Флойда-Уоршелла
-  for (int k = 0; k < verticesCount; ++k) {
+  // Инициализация матрицы расстояний по существующим рёбрам
+  AdjacencyIndex index = graph.GetAdjacencyIndex();
+  VisitWeightType(index.weight_type, [&](auto zero) {
+    const auto* weights = index.GetWeights<decltype(zero)>();
     for (int i = 0; i < verticesCount; ++i) {
-      for (int j = 0; j < verticesCount; ++j) {
-        if (distance[i][k] != std::numeric_limits<int>::max() &&
-            distance[k][j] != std::numeric_limits<int>::max()) {
-          distance[i][j] =
-              std::min(distance[i][j], distance[i][k] + distance[k][j]);
+      int* row = distance.data() + i * size;
+      row[i] = 0;  // Расстояние до самого себя равно 0
+      for (int e = index.offsets[i]; e < index.offsets[i + 1]; ++e) {
+        if (weights[e] > 0) {
+          row[index.neighbors[e]] = weights[e];
         }
       }
     }
+  });
+
+  int blocks = size / block;
+  ThreadPool pool(CountThreads(threads, blocks * blocks));
+  RunFloydWarshall(distance.data(), size, &pool);
+
+  for (int i = 0; i < verticesCount; ++i) {
+    const int* row = distance.data() + i * size;
+    std::copy(row, row + verticesCount, result.GetRow(i));
   }
+}
 
-  return distance;
+std::vector<std::vector<int>> GraphAlgorithms::GetDistanceTable(
+    Graph& graph, const std::vector<int>& sources,
+    const std::vector<int>& targets, int threads) {
+  std::vector<std::vector<int>> result(sources.size(),
+                                       std::vector<int>(targets.size()));
+  ThreadPool pool(CountThreads(threads, sources.size()));
+  FindDistanceRows(graph.GetAdjacencyIndex(), sources.data(), sources.size(),
+                   targets, &pool, [&](int i) { return result[i].data(); });
+  return result;
 }
 
 TsmResult GraphAlgorithms::SolveTravelingSalesmanProblem(Graph& graph) {
@@ -2,10 +2,13 @@
 #define A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_ALGORITHMS_S21_GRAPH_ALGORITHMS_H
 
 #include <cstring>
-#include <set>
 
 #include "../s21_containers/s21_queue.h"
 #include "../s21_graph/s21_graph.h"
+#include "s21_contraction_hierarchy.h"
+#include "s21_distance_matrix.h"
+#include "s21_landmark_table.h"
+#include "s21_search_workspace.h"
 #include "s21_tsp_problem.h"
 
 namespace s21 {
@@ -17,14 +20,127 @@ struct TsmCompare {
   bool overflow_error;
 };
 
+struct RouteResult {
+  std::vector<int> vertices;  // вершины маршрута от начала до конца
+  int distance;               // длина маршрута
+};
+
+// Способ обхода в ширину
+enum class TraversalMode {
+  kTopDown,              // фронт по очереди, как в BreadthFirstSearch
+  kDirectionOptimizing,  // широкие уровни ищут родителя во фронте снизу вверх
+  kParallel,             // фронт уровня разбирают несколько потоков
+};
+
+// Дерево обхода в ширину. order — посещённые вершины (нумерация с 1) по
+// уровням, level[i] и parent[i] — уровень и родитель вершины i + 1: -1 и 0
+// для недостижимых, у начальной вершины 0 и 0.
+struct BreadthFirstTree {
+  std::vector<int> order;
+  std::vector<int> level;
+  std::vector<int> parent;
+};
+
+// Дерево обхода в глубину. order — посещённые вершины (нумерация с 1) в
+// порядке открытия, parent[i] — родитель вершины i + 1, 0 у начальной и
+// недостижимых. discovery[i] и finish[i] — время открытия и закрытия вершины
+// i + 1, от 1 до удвоенного числа посещённых вершин, 0 у недостижимых;
+// заполняются, только если их запросили.
+struct DepthFirstTree {
+  std::vector<int> order;
+  std::vector<int> parent;
+  std::vector<int> discovery;
+  std::vector<int> finish;
+};
+
+// Алгоритм поиска минимального остовного дерева
+enum class SpanningTreeMode {
+  kPrim,     // дерево растёт от вершины по куче рёбер до него
+  kKruskal,  // рёбра по возрастанию веса, сортируются на нескольких потоках
+};
+
+// Ребро остова (нумерация с 1): у Прима from уже была в дереве, когда
+// ребро присоединило to, у Краскала from < to
+struct SpanningEdge {
+  int from;
+  int to;
+  int weight;
+};
+
+struct SpanningTree {
+  std::vector<SpanningEdge> edges;  // в порядке добавления в остов
+  long long weight;                 // суммарный вес рёбер
+  int components;  // число деревьев остовного леса, 1 для связного графа
+};
+
 class GraphAlgorithms {
  public:
   std::vector<int> DepthFirstSearch(Graph &graph, int start_vertex);
+  // Обход в глубину с родителями вершин, with_times — ещё и со временами
+  // открытия и закрытия. Соседи обходятся от младших к старшим, каждое ребро
+  // просматривается один раз.
+  DepthFirstTree DepthFirstSearch(Graph &graph, int start_vertex,
+                                  bool with_times);
   std::vector<int> BreadthFirstSearch(Graph &graph, int start_vertex);
+  // Обход в ширину с уровнями и родителями вершин. В режиме kTopDown order
+  // совпадает с BreadthFirstSearch, в kDirectionOptimizing тот же набор
+  // вершин по тем же уровням, но внутри уровня порядок может отличаться.
+  // kParallel обходит на threads потоках, 0 — по числу ядер: уровни те же,
+  // порядок внутри уровня и выбор родителя зависят от работы потоков.
+  BreadthFirstTree BreadthFirstSearch(Graph &graph, int start_vertex,
+                                      TraversalMode mode, int threads = 0);
   int GetShortestPathBetweenVertices(Graph &graph, int vertex1, int vertex2);
+  int GetShortestPathBetweenVertices(
+      Graph &graph, int vertex1, int vertex2, SearchWorkspace &workspace,
+      SearchMode mode = SearchMode::kUnidirectional);
+  RouteResult GetShortestRouteBetweenVertices(
+      Graph &graph, int vertex1, int vertex2, SearchWorkspace &workspace,
+      SearchMode mode = SearchMode::kUnidirectional);
+  // Таблица опорных вершин для SearchMode::kLandmarks, считается при первом
+  // запросе к загруженному графу и хранится до загрузки другого. Load и
+  // Export возвращают коды ошибок двоичных файлов (s21_binary_file.h).
+  const LandmarkTable &GetLandmarkTable(Graph &graph);
+  int LoadLandmarkTable(Graph &graph, std::string filename);
+  int ExportLandmarkTable(Graph &graph, std::string filename);
+  // Иерархия сжатия для SearchMode::kContractionHierarchy, строится и
+  // хранится так же, как таблица опорных вершин
+  const ContractionHierarchy &GetContractionHierarchy(Graph &graph);
+  int LoadContractionHierarchy(Graph &graph, std::string filename);
+  int ExportContractionHierarchy(Graph &graph, std::string filename);
+  // Флойд-Уоршелл для плотных графов или Дейкстра от каждой вершины для
+  // разреженных, на threads потоках, 0 — по числу ядер. Матрицы обоих
+  // способов совпадают поэлементно: расстояния меньше
+  // numeric_limits<int>::max() точные, иначе numeric_limits<int>::max().
   std::vector<std::vector<int>> GetShortestPathsBetweenAllVertices(
-      Graph &graph);
-  std::vector<std::vector<int>> GetLeastSpanningTree(Graph &graph);
+      Graph &graph, int threads = 0);
+  // То же в матрицу result, которая пересоздаётся в памяти, если её размер
+  // не равен числу вершин графа или она открыта из файла только для чтения
+  // (DistanceMatrix::Open). Матрица в новом файле (DistanceMatrix::CreateFile)
+  // может быть больше оперативной памяти.
+  void GetShortestPathsBetweenAllVertices(Graph &graph, DistanceMatrix &result,
+                                          int threads = 0);
+  // Передаёт строки матрицы расстояний в sink по порядку вершин, не храня
+  // всю матрицу: строки считаются Дейкстрой порциями на threads потоках
+  void StreamShortestPathsBetweenAllVertices(Graph &graph,
+                                             const DistanceRowSink &sink,
+                                             int threads = 0);
+  // Расстояния от каждой вершины sources до каждой вершины targets
+  // (нумерация с 1): строка на источник, расстояние от вершины до себя 0,
+  // numeric_limits<int>::max() для недостижимых и несуществующих вершин.
+  // Источники считаются параллельно на threads потоках, 0 — по числу ядер.
+  std::vector<std::vector<int>> GetDistanceTable(
+      Graph &graph, const std::vector<int> &sources,
+      const std::vector<int> &targets, int threads = 0);
+  // Матрица смежности остовного дерева из GetLeastSpanningTreeEdges
+  std::vector<std::vector<int>> GetLeastSpanningTree(
+      Graph &graph, SpanningTreeMode mode = SpanningTreeMode::kPrim);
+  // Минимальный остовный лес. Прим растит дерево от вершины 1, затем от
+  // младшей не вошедшей вершины каждой следующей компоненты; Краскал
+  // сортирует рёбра на threads потоках, 0 — по числу ядер. Суммарный вес у
+  // обоих одинаков.
+  SpanningTree GetLeastSpanningTreeEdges(
+      Graph &graph, SpanningTreeMode mode = SpanningTreeMode::kPrim,
+      int threads = 0);
   TsmResult SolveTravelingSalesmanProblem(Graph &graph);
   TsmResult SolveTravelingSalesmanProblemAnt(Graph &graph);
   TsmResult SolveTravelingSalesmanProblemGreedy(Graph &graph);
@@ -36,6 +152,12 @@ class GraphAlgorithms {
   bool CheckDuration(std::chrono::_V2::steady_clock::time_point end_time,
                      std::chrono::_V2::steady_clock::time_point start_time,
                      int64_t &result);
+  int FindShortestDistance(Graph &graph, int vertex1, int vertex2,
+                           SearchWorkspace &workspace, SearchMode mode);
+  void GetShortestPathsFloydWarshall(Graph &graph, DistanceMatrix &result,
+                                     int threads);
+  LandmarkTable landmarks_;
+  ContractionHierarchy hierarchy_;
 };
 
 }  // namespace s21
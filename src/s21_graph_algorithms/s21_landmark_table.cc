@@ -0,0 +1,233 @@
+#include "s21_landmark_table.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "../s21_containers/s21_indexed_heap.h"
+#include "../s21_graph/s21_binary_file.h"
+
+namespace s21 {
+
+namespace {
+
+// Файл таблицы: заголовок, номера опорных вершин (int), затем расстояния по
+// строке из count значений размера distance_size на каждую вершину. Граф, для
+// которого посчитана таблица, узнаётся по отпечатку его индекса смежности.
+const char kLandmarkMagic[8] = {'S', '2', '1', 'L', 'M', 'A', 'R', 'K'};
+const uint32_t kLandmarkVersion = 1;
+
+struct LandmarkHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t distance_size;
+  int64_t vertices;
+  int64_t count;
+  uint64_t fingerprint;  // отпечаток графа
+  uint64_t checksum;     // по номерам опорных вершин и расстояниям
+};
+
+// Расстояния от source до всех вершин, numeric_limits<int>::max() для
+// недостижимых
+template <typename W>
+void FindDistances(const AdjacencyIndex &index, int source, int *distances) {
+  const int infinity = std::numeric_limits<int>::max();
+  const W *weights = index.GetWeights<W>();
+  std::fill(distances, distances + index.vertices, infinity);
+  indexed_heap<int> heap(index.vertices);
+  distances[source] = 0;
+  heap.push(source, 0);
+  while (!heap.empty()) {
+    int vertex = heap.top();
+    heap.pop();
+    long long distance = distances[vertex];
+    for (int e = index.offsets[vertex]; e < index.offsets[vertex + 1]; ++e) {
+      int neighbor = index.neighbors[e];
+      long long candidate = distance + weights[e];
+      if (candidate < distances[neighbor]) {
+        distances[neighbor] = candidate;
+        heap.push_or_decrease(neighbor, candidate);
+      }
+    }
+  }
+}
+
+// Вершина с наибольшим расстоянием (недостижимые дальше всех), при равенстве
+// — с меньшим номером
+int FindFarthest(const int *distances, int n) {
+  return std::max_element(distances, distances + n) - distances;
+}
+
+}  // namespace
+
+void LandmarkTable::Build(const Graph &graph, int count) {
+  Clear();
+  AdjacencyIndex index = graph.GetAdjacencyIndex();
+  int n = index.vertices;
+  count = std::max(0, std::min(count, n));
+  auto find_distances = [&](int source, int *distances) {
+    VisitWeightType(index.weight_type, [&](auto zero) {
+      FindDistances<decltype(zero)>(index, source, distances);
+    });
+  };
+
+  // Расстояния считаются по строке на опорную вершину и затем
+  // переставляются в строки вершин
+  std::vector<int> by_landmark((size_t)count * n);
+  std::vector<int> nearest(n, std::numeric_limits<int>::max());
+  if (count > 0) {
+    find_distances(0, by_landmark.data());
+    int next = FindFarthest(by_landmark.data(), n);
+    while (count_ < count && (count_ == 0 || nearest[next] > 0)) {
+      int *row = by_landmark.data() + (size_t)count_ * n;
+      find_distances(next, row);
+      for (int v = 0; v < n; v++) nearest[v] = std::min(nearest[v], row[v]);
+      landmarks_.push_back(next);
+      count_++;
+      next = FindFarthest(nearest.data(), n);
+    }
+  }
+
+  const int unreachable = std::numeric_limits<int>::max();
+  int max_distance = 0;
+  for (int distance : by_landmark) {
+    if (distance != unreachable) {
+      max_distance = std::max(max_distance, distance);
+    }
+  }
+  vertices_ = n;
+  distance_type_ = GetNarrowestWeightType(max_distance + 1);
+  distances_.assign((size_t)n * count_ * GetWeightSize(distance_type_));
+  VisitWeightType(distance_type_, [&](auto zero) {
+    using D = decltype(zero);
+    D *distances = reinterpret_cast<D *>(distances_.data());
+    const D limit = std::numeric_limits<D>::max();
+    for (int l = 0; l < count_; l++) {
+      const int *row = by_landmark.data() + (size_t)l * n;
+      for (int v = 0; v < n; v++) {
+        distances[(size_t)v * count_ + l] =
+            row[v] == unreachable ? limit : row[v];
+      }
+    }
+  });
+  revision_ = graph.GetRevision();
+  fingerprint_ = graph.GetFingerprint();
+}
+
+int LandmarkTable::Export(std::string filename) const {
+  int error = 0;
+  if (!std::filesystem::exists(filename)) {
+    std::ofstream out(filename, std::ios::binary);
+    if (!out.is_open()) {
+      error = 1;
+    } else {
+      LandmarkHeader header = {};
+      std::memcpy(header.magic, kLandmarkMagic, sizeof(header.magic));
+      header.version = kLandmarkVersion;
+      header.distance_size = GetWeightSize(distance_type_);
+      header.vertices = vertices_;
+      header.count = count_;
+      header.fingerprint = fingerprint_;
+      size_t landmark_bytes = landmarks_.size() * sizeof(int);
+      header.checksum =
+          HashBytes(kFnvOffset, landmarks_.data(), landmark_bytes);
+      header.checksum =
+          HashBytes(header.checksum, distances_.data(), distances_.size());
+      out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+      out.write(reinterpret_cast<const char *>(landmarks_.data()),
+                landmark_bytes);
+      out.write(reinterpret_cast<const char *>(distances_.data()),
+                distances_.size());
+      if (!out) error = 1;
+      out.close();
+    }
+  } else {
+    error = 4;
+  }
+  return error;
+}
+
+int LandmarkTable::Load(const Graph &graph, std::string filename) {
+  int error = 0;
+  std::ifstream in(filename, std::ios::binary);
+  if (!in.is_open() || !std::filesystem::is_regular_file(filename)) {
+    error = 1;
+  }
+  LandmarkHeader header = {};
+  size_t file_size = 0;
+  size_t landmark_bytes = 0;
+  size_t distance_bytes = 0;
+  if (!error) {
+    file_size = std::filesystem::file_size(filename);
+    if (!in.read(reinterpret_cast<char *>(&header), sizeof(header))) error = 2;
+  }
+  if (!error) {
+    uint32_t size = header.distance_size;
+    if (std::memcmp(header.magic, kLandmarkMagic, sizeof(header.magic)) ||
+        header.version != kLandmarkVersion ||
+        (size != 1 && size != 2 && size != 4) ||
+        header.vertices != graph.GetVerticesCount() || header.count < 0 ||
+        header.count > header.vertices ||
+        header.fingerprint != graph.GetFingerprint()) {
+      error = 2;
+    } else {
+      landmark_bytes = header.count * sizeof(int);
+      distance_bytes = (size_t)header.vertices * header.count * size;
+      if (file_size != sizeof(header) + landmark_bytes + distance_bytes) {
+        error = 2;
+      }
+    }
+  }
+  std::vector<int> landmarks;
+  aligned_buffer<unsigned char> distances;
+  if (!error) {
+    landmarks.resize(header.count);
+    distances.assign(distance_bytes);
+    in.read(reinterpret_cast<char *>(landmarks.data()), landmark_bytes);
+    in.read(reinterpret_cast<char *>(distances.data()), distance_bytes);
+    uint64_t checksum = HashBytes(kFnvOffset, landmarks.data(), landmark_bytes);
+    checksum = HashBytes(checksum, distances.data(), distance_bytes);
+    if (!in || checksum != header.checksum) error = 2;
+    for (int landmark : landmarks) {
+      if (landmark < 0 || landmark >= header.vertices) error = 2;
+    }
+  }
+  if (!error) {
+    Clear();
+    vertices_ = header.vertices;
+    count_ = header.count;
+    distance_type_ = GetWeightTypeOfSize(header.distance_size);
+    landmarks_ = std::move(landmarks);
+    distances_ = std::move(distances);
+    revision_ = graph.GetRevision();
+    fingerprint_ = header.fingerprint;
+  }
+  return error;
+}
+
+void LandmarkTable::Clear() {
+  vertices_ = 0;
+  count_ = 0;
+  distance_type_ = WeightType::kUint8;
+  revision_ = 0;
+  fingerprint_ = 0;
+  landmarks_.clear();
+  distances_.clear();
+}
+
+bool LandmarkTable::AreSeparated(int vertex, int target) const {
+  const int unreachable = GetWeightLimit(distance_type_);
+  return VisitWeightType(distance_type_, [&](auto zero) {
+    using D = decltype(zero);
+    const D *vertex_row = GetDistances<D>(vertex);
+    const D *target_row = GetDistances<D>(target);
+    bool separated = false;
+    for (int l = 0; l < count_ && !separated; l++) {
+      separated = (vertex_row[l] == unreachable) !=
+                  (target_row[l] == unreachable);
+    }
+    return separated;
+  });
+}
+
+}  // namespace s21
\ No newline at end of file
@@ -0,0 +1,79 @@
+#ifndef A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_ALGORITHMS_S21_LANDMARK_TABLE_H
+#define A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_ALGORITHMS_S21_LANDMARK_TABLE_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "../s21_containers/s21_aligned_buffer.h"
+#include "../s21_graph/s21_graph.h"
+
+namespace s21 {
+
+// Расстояния от нескольких опорных вершин (landmarks) до всех вершин графа
+// для поиска A* (ALT): по неравенству треугольника |d(l, t) - d(l, v)| не
+// больше d(v, t) для любой опорной вершины l, поэтому наибольшая такая
+// разность — допустимая и согласованная оценка остатка пути от v до t.
+// Расстояния вершины лежат подряд в самом узком вмещающем их типе, значение
+// GetWeightLimit(GetDistanceType()) означает, что вершина недостижима.
+class LandmarkTable {
+ public:
+  static const int kDefaultCount = 16;
+
+  // Выбирает до count опорных вершин дальними точками: каждая следующая —
+  // самая далёкая от уже выбранных, первая — самая далёкая от вершины 1
+  void Build(const Graph &graph, int count = kDefaultCount);
+  // Коды ошибок общие для двоичных файлов, см. s21_binary_file.h
+  int Load(const Graph &graph, std::string filename);
+  int Export(std::string filename) const;
+  void Clear();
+
+  // Посчитана ли таблица для текущего содержимого graph
+  bool IsBuiltFor(const Graph &graph) const {
+    return revision_ == graph.GetRevision();
+  }
+  int GetCount() const { return count_; }
+  int GetVerticesCount() const { return vertices_; }
+  const std::vector<int> &GetLandmarks() const { return landmarks_; }
+  WeightType GetDistanceType() const { return distance_type_; }
+  // Расстояния от опорных вершин до vertex (нумерация с 0), D должен
+  // соответствовать GetDistanceType()
+  template <typename D>
+  const D *GetDistances(int vertex) const {
+    return reinterpret_cast<const D *>(distances_.data()) +
+           (size_t)vertex * count_;
+  }
+
+  // Нижняя оценка d(v, t) по строкам расстояний вершин v и t
+  template <typename D>
+  static int GetLowerBound(const D *vertex_row, const D *target_row,
+                           int count, int unreachable) {
+    int bound = 0;
+    for (int l = 0; l < count; ++l) {
+      int to_vertex = vertex_row[l], to_target = target_row[l];
+      if (to_vertex != unreachable && to_target != unreachable) {
+        int difference = std::abs(to_vertex - to_target);
+        if (difference > bound) bound = difference;
+      }
+    }
+    return bound;
+  }
+
+  // Лежат ли vertex и target в разных компонентах связности, по тому, что
+  // одна из них достижима из какой-то опорной вершины, а другая нет
+  bool AreSeparated(int vertex, int target) const;
+
+ private:
+  int vertices_ = 0;
+  int count_ = 0;
+  WeightType distance_type_ = WeightType::kUint8;
+  uint64_t revision_ = 0;
+  uint64_t fingerprint_ = 0;
+  std::vector<int> landmarks_;
+  aligned_buffer<unsigned char> distances_;
+};
+
+}  // namespace s21
+
+#endif  // A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_ALGORITHMS_S21_LANDMARK_TABLE_H
\ No newline at end of file
@@ -0,0 +1,147 @@
+#ifndef A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_ALGORITHMS_S21_SEARCH_WORKSPACE_H
+#define A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_ALGORITHMS_S21_SEARCH_WORKSPACE_H
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "../s21_containers/s21_indexed_heap.h"
+
+namespace s21 {
+
+// Поиск кратчайшего пути между двумя вершинами
+enum class SearchMode {
+  kUnidirectional,        // Дейкстра от первой вершины
+  kBidirectional,         // Дейкстра от обеих вершин до встречи посередине
+  kLandmarks,             // A* с оценкой остатка пути по опорным вершинам
+  kContractionHierarchy,  // поиски вверх по иерархии сжатия от обеих вершин
+};
+
+// Дерево поиска в одном направлении: метки вершин (расстояние и родитель) и
+// куча фронта. Метки помечены номером запроса (эпохой): метка со старой
+// эпохой считается пустой, поэтому новый запрос не очищает массивы и стоит
+// только тех вершин, до которых дошёл поиск.
+class SearchTree {
+ public:
+  // Начинает новый запрос на графе из vertices вершин (нумерация с 0)
+  void Begin(int vertices) {
+    if ((int)labels_.size() != vertices) {
+      labels_.assign(vertices, Label());
+      heap_.reset(vertices);
+      epoch_ = 0;
+    } else {
+      heap_.clear();
+    }
+    if (++epoch_ == 0) {
+      // Номера эпох исчерпаны: старые метки сбрасываются один раз
+      for (Label &label : labels_) label.epoch = 0;
+      epoch_ = 1;
+    }
+    settled_ = 0;
+  }
+
+  bool IsReached(int vertex) const {
+    return labels_[vertex].epoch == epoch_;
+  }
+
+  // Найденное расстояние или numeric_limits<int>::max() для недостигнутой
+  int GetDistance(int vertex) const {
+    return IsReached(vertex) ? labels_[vertex].distance
+                             : std::numeric_limits<int>::max();
+  }
+
+  // Предыдущая вершина пути или -1 для корня и недостигнутых
+  int GetParent(int vertex) const {
+    return IsReached(vertex) ? labels_[vertex].parent : -1;
+  }
+
+  void SetLabel(int vertex, int distance, int parent) {
+    labels_[vertex] = {epoch_, distance, parent};
+  }
+
+  indexed_heap<int> &GetHeap() { return heap_; }
+
+  // Извлекает из кучи ближайшую вершину, её расстояние окончательно
+  int Settle() {
+    int vertex = heap_.top();
+    heap_.pop();
+    settled_++;
+    return vertex;
+  }
+
+  int GetSettledCount() const { return settled_; }
+
+ private:
+  // Поля метки лежат рядом, чтобы проверка и обновление вершины читали одну
+  // строку кэша
+  struct Label {
+    unsigned epoch = 0;
+    int distance = 0;
+    int parent = -1;
+  };
+
+  std::vector<Label> labels_;
+  indexed_heap<int> heap_;
+  unsigned epoch_ = 0;
+  int settled_ = 0;
+};
+
+// Память поиска кратчайшего пути, которую вызывающий переиспользует между
+// запросами: деревья поиска от первой вершины и, в режимах с поиском от
+// обеих вершин, от второй. Дерево от второй вершины заводится при первом
+// таком запросе.
+class SearchWorkspace {
+ public:
+  void Begin(int vertices, SearchMode mode) {
+    bidirectional_ = mode == SearchMode::kBidirectional ||
+                     mode == SearchMode::kContractionHierarchy;
+    meeting_ = -1;
+    forward_.Begin(vertices);
+    if (bidirectional_) backward_.Begin(vertices);
+  }
+
+  SearchTree &GetForward() { return forward_; }
+  SearchTree &GetBackward() { return backward_; }
+
+  // Вершина, в которой сошлись деревья лучшего найденного пути: путь идёт
+  // по дереву от первой вершины до неё, затем по дереву от второй
+  void SetMeeting(int vertex) { meeting_ = vertex; }
+
+  // Число извлечённых из куч вершин последнего запроса
+  int GetSettledCount() const {
+    int count = forward_.GetSettledCount();
+    if (bidirectional_) count += backward_.GetSettledCount();
+    return count;
+  }
+
+  // Маршрут последнего запроса до target с нумерацией вершин с 1, пустой,
+  // если target не достигнута. Маршрут по иерархии сжатия содержит
+  // сокращения, их разворачивает ContractionHierarchy::Unpack.
+  std::vector<int> GetRoute(int target) const {
+    std::vector<int> route;
+    int last = bidirectional_ ? meeting_ : target;
+    if (last != -1 && forward_.IsReached(last)) {
+      for (int v = last; v != -1; v = forward_.GetParent(v)) {
+        route.push_back(v + 1);
+      }
+      std::reverse(route.begin(), route.end());
+      if (bidirectional_) {
+        for (int v = backward_.GetParent(last); v != -1;
+             v = backward_.GetParent(v)) {
+          route.push_back(v + 1);
+        }
+      }
+    }
+    return route;
+  }
+
+ private:
+  SearchTree forward_;
+  SearchTree backward_;
+  bool bidirectional_ = false;
+  int meeting_ = -1;
+};
+
+}  // namespace s21
+
+#endif  // A2_SIMPLENAVIGATOR_V_1_0_CPP_1_SRC_S21_GRAPH_ALGORITHMS_S21_SEARCH_WORKSPACE_H
\ No newline at end of file
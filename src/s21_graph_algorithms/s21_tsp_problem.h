@@ -87,16 +87,11 @@ class AntColony {
 
   int SelectNextVertex(int currentVertex, const std::vector<bool>& visited) {
     double total = 0;
-    std::vector<double> probabilities(verticesCount_, 0.0);
-
-    auto adjacentVertices = graph_.GetAdjacentVertices(currentVertex + 1);
-    for (int neighbor : adjacentVertices) {
-      int neighborIndex = neighbor - 1;
-      if (!visited[neighborIndex]) {
-        double edgeWeight = graph_.GetVergeWeight(currentVertex + 1, neighbor);
-        probabilities[neighborIndex] =
-            pheromones_[currentVertex][neighborIndex] / edgeWeight;
-        total += probabilities[neighborIndex];
+
+    NeighborRange neighbors = graph_.GetNeighbors(currentVertex + 1);
+    for (Neighbor neighbor : neighbors) {
+      if (!visited[neighbor.vertex - 1]) {
+        total += Attractiveness(currentVertex, neighbor);
       }
     }
 
@@ -105,11 +100,11 @@ class AntColony {
     double random = static_cast<double>(rand()) / RAND_MAX;
     double cumulative = 0.0;
 
-    for (size_t i = 0; i < verticesCount_; ++i) {
-      if (probabilities[i] > 0) {
-        cumulative += probabilities[i] / total;
+    for (Neighbor neighbor : neighbors) {
+      if (!visited[neighbor.vertex - 1]) {
+        cumulative += Attractiveness(currentVertex, neighbor) / total;
         if (cumulative >= random) {
-          return i;
+          return neighbor.vertex - 1;
         }
       }
     }
@@ -117,6 +112,10 @@ class AntColony {
     return -1;  // Нет доступного соседа
   }
 
+  double Attractiveness(int currentVertex, Neighbor neighbor) const {
+    return pheromones_[currentVertex][neighbor.vertex - 1] / neighbor.weight;
+  }
+
   double CalculatePathCost(const std::vector<int>& path) {
     double cost = 0.0;
     for (size_t i = 0; i < path.size() - 1; ++i) {
@@ -162,15 +161,12 @@ class GreedyTSP {
       int nextVertex = -1;
       double minWeight = std::numeric_limits<double>::max();
 
-      auto adjacentVertices = graph_.GetAdjacentVertices(currentVertex + 1);
-      for (int neighbor : adjacentVertices) {
-        int neighborIndex = neighbor - 1;
-        if (!visited[neighborIndex]) {
-          double weight = graph_.GetVergeWeight(currentVertex + 1, neighbor);
-          if (weight < minWeight) {
-            minWeight = weight;
-            nextVertex = neighborIndex;
-          }
+      // При равных весах выбирается вершина с большим номером
+      for (Neighbor neighbor : graph_.GetNeighbors(currentVertex + 1)) {
+        int neighborIndex = neighbor.vertex - 1;
+        if (!visited[neighborIndex] && neighbor.weight <= minWeight) {
+          minWeight = neighbor.weight;
+          nextVertex = neighborIndex;
         }
       }
 